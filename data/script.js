@@ -5,26 +5,62 @@ document.addEventListener('DOMContentLoaded', () => {
 
     const state = {
         ws: null,
+        wsConnecting: false,    // Bilet isteniyor
         wsConnected: false,
         reconnectTimer: null,
         reconnectAttempts: 0,
         maxReconnectAttempts: 5,
         authenticated: false,
         logPaused: false,
-        autoScroll: true
+        autoScroll: true,
+        logCursor: null,
+        logRefreshTimer: null,
+        logSeq: null,       // Sıradaki beklenen log seq'i (yeniden bağlanınca buradan devam edilir)
+        logBoot: null,      // logSeq'in ait olduğu açılışın kimliği
+        onLogBatch: null,
+        jobWaiters: {},     // UART iş id'si -> sonucu bekleyen fonksiyon
+        status: null,       // Son tam durum + uygulanan yamalar (version ile)
+        bootstrap: []       // Sayfa açılışında tek /api/batch ile alınacak GET'ler
     };
 
+    const JOB_TIMEOUT = 15000;        // UART işi için en uzun bekleme (ms)
+    const JOB_POLL_INTERVAL = 500;    // WebSocket yokken /api/jobs yoklama aralığı (ms)
+    // Durum/log/arıza olayları için WebSocket kodlaması (hata ayıklarken
+    // localStorage.wsEncoding = 'json' ile okunur metne dönülebilir)
+    const WS_ENCODING = localStorage.getItem('wsEncoding') || (window.TextDecoder ? 'msgpack' : 'json');
+
     // --- WebSocket Yönetimi ---
 
+    // Bağlantı oturuma tek kullanımlık biletle bağlanır; oturum kapanınca
+    // (çıkış, süre dolması) sunucu bağlantıyı keser
     function connectWebSocket() {
-        if (state.ws || state.reconnectAttempts >= state.maxReconnectAttempts) return;
+        if (state.ws || state.wsConnecting || state.reconnectAttempts >= state.maxReconnectAttempts) return;
+
+        state.wsConnecting = true;
+        updateWSStatus(false, 'Bağlanıyor...');
+        fetch('/api/ws-ticket', { method: 'POST' })
+            .then(r => {
+                if (r.status === 401) window.location.href = '/login';
+                return r.ok ? r.json() : Promise.reject(new Error('HTTP ' + r.status));
+            })
+            .then(data => {
+                state.wsConnecting = false;
+                openWebSocket(data.ticket);
+            })
+            .catch(error => {
+                state.wsConnecting = false;
+                console.error('WebSocket bileti alınamadı:', error);
+                scheduleReconnect();
+            });
+    }
 
+    function openWebSocket(ticket) {
         try {
-            const wsUrl = `ws://${window.location.hostname}:81`;
-            console.log('WebSocket bağlantısı deneniyor:', wsUrl);
-            updateWSStatus(false, 'Bağlanıyor...');
+            const wsUrl = `ws://${window.location.hostname}:81/?t=${ticket}`;
+            console.log('WebSocket bağlantısı deneniyor');
 
             state.ws = new WebSocket(wsUrl);
+            state.ws.binaryType = 'arraybuffer';
             state.ws.onopen = onWsOpen;
             state.ws.onmessage = onWsMessage;
             state.ws.onclose = onWsClose;
@@ -41,33 +77,109 @@ document.addEventListener('DOMContentLoaded', () => {
         state.reconnectAttempts = 0;
         updateWSStatus(true, 'Bağlı');
         
-        // Basit bir kimlik doğrulama token'ı gönder
-        state.ws.send(JSON.stringify({ cmd: 'auth', token: 'session_' + Date.now() }));
+        // Oturum çerezi el sıkışmada doğrulandı; istemciyi yayınlara kaydet
+        state.ws.send(JSON.stringify({ cmd: 'auth', encoding: WS_ENCODING }));
+    }
+
+    // MessagePack çözücü - cihazın ürettiği tipler (map, array, str, int, float, bool, nil)
+    function decodeMsgPack(buffer) {
+        const view = new DataView(buffer);
+        const bytes = new Uint8Array(buffer);
+        const utf8 = new TextDecoder();
+        let pos = 0;
+
+        function str(length) {
+            const s = utf8.decode(bytes.subarray(pos, pos + length));
+            pos += length;
+            return s;
+        }
+        function array(length) {
+            const a = [];
+            for (let i = 0; i < length; i++) a.push(read());
+            return a;
+        }
+        function map(length) {
+            const o = {};
+            for (let i = 0; i < length; i++) {
+                const key = read();
+                o[key] = read();
+            }
+            return o;
+        }
+        function read() {
+            const b = bytes[pos++];
+            if (b <= 0x7f) return b;
+            if (b >= 0xe0) return b - 0x100;
+            if ((b & 0xf0) === 0x80) return map(b & 0x0f);
+            if ((b & 0xf0) === 0x90) return array(b & 0x0f);
+            if ((b & 0xe0) === 0xa0) return str(b & 0x1f);
+            let v;
+            switch (b) {
+                case 0xc0: return null;
+                case 0xc2: return false;
+                case 0xc3: return true;
+                case 0xca: v = view.getFloat32(pos); pos += 4; return v;
+                case 0xcb: v = view.getFloat64(pos); pos += 8; return v;
+                case 0xcc: return bytes[pos++];
+                case 0xcd: v = view.getUint16(pos); pos += 2; return v;
+                case 0xce: v = view.getUint32(pos); pos += 4; return v;
+                case 0xcf: v = view.getUint32(pos) * 4294967296 + view.getUint32(pos + 4); pos += 8; return v;
+                case 0xd0: v = view.getInt8(pos); pos += 1; return v;
+                case 0xd1: v = view.getInt16(pos); pos += 2; return v;
+                case 0xd2: v = view.getInt32(pos); pos += 4; return v;
+                case 0xd3: v = view.getInt32(pos) * 4294967296 + view.getUint32(pos + 4); pos += 8; return v;
+                case 0xd9: return str(bytes[pos++]);
+                case 0xda: v = view.getUint16(pos); pos += 2; return str(v);
+                case 0xdb: v = view.getUint32(pos); pos += 4; return str(v);
+                case 0xdc: v = view.getUint16(pos); pos += 2; return array(v);
+                case 0xdd: v = view.getUint32(pos); pos += 4; return array(v);
+                case 0xde: v = view.getUint16(pos); pos += 2; return map(v);
+                case 0xdf: v = view.getUint32(pos); pos += 4; return map(v);
+            }
+            throw new Error('Desteklenmeyen MessagePack tipi: 0x' + b.toString(16));
+        }
+        return read();
     }
 
     function onWsMessage(event) {
         try {
-            const data = JSON.parse(event.data);
+            const data = typeof event.data === 'string' ? JSON.parse(event.data) : decodeMsgPack(event.data);
             console.log('WS Mesajı:', data);
 
             switch (data.type) {
                 case 'auth_success':
                     state.authenticated = true;
                     console.log('WebSocket kimlik doğrulama başarılı');
-                    // Gerekli verileri iste
-                    if (document.getElementById('logContainer')) {
-                         state.ws.send(JSON.stringify({ cmd: 'get_logs' }));
-                    }
+                    // Gerekli verileri iste (log sayfası kayıtları /api/logs'tan alır)
                     if (document.querySelector('.status-grid')) {
                          state.ws.send(JSON.stringify({ cmd: 'get_status' }));
                     }
+                    // Log sayfası: kopukluk süresince kaçırılan kayıtlardan devam et
+                    subscribeLogs();
                     break;
                 case 'status':
+                    state.status = data;
                     updateSystemStatus(data);
                     break;
+                case 'status_patch':
+                    // Elimizdeki versiyon üzerine değilse tam görüntü iste
+                    if (!state.status || state.status.version !== data.base) {
+                        sendWsMessage({ cmd: 'get_status' });
+                        break;
+                    }
+                    Object.assign(state.status, data.set);
+                    state.status.version = data.version;
+                    updateSystemStatus(state.status);
+                    break;
                 case 'log':
                     if (!state.logPaused) addLogEntry(data);
                     break;
+                case 'logs':
+                    if (state.onLogBatch) state.onLogBatch(data);
+                    break;
+                case 'job':
+                    if (state.jobWaiters[data.id]) state.jobWaiters[data.id](data);
+                    break;
                 case 'error':
                      showMessage(data.message, 'error');
                      break;
@@ -82,6 +194,7 @@ document.addEventListener('DOMContentLoaded', () => {
         state.ws = null;
         state.wsConnected = false;
         state.authenticated = false;
+        state.status = null;
         updateWSStatus(false, 'Bağlantı Yok');
 
         if (event.code !== 1000) { // 1000 = Normal kapanış
@@ -123,6 +236,106 @@ document.addEventListener('DOMContentLoaded', () => {
         }
     }
 
+    function subscribeLogs() {
+        if (state.logSeq === null || !state.authenticated) return;
+        sendWsMessage({ cmd: 'logs_since', seq: state.logSeq, boot: state.logBoot });
+    }
+
+    // --- UART İşleri ---
+
+    // UART'a bağlı istekler hemen 202 + iş id'si döner. Sonuç WebSocket "job"
+    // olayıyla gelir; WebSocket yoksa (veya olay kaçarsa) /api/jobs/{id} yoklanır.
+    function runUartJob(endpoint, body) {
+        const options = { method: 'POST' };
+        if (body) options.body = body;
+        return fetch(endpoint, options)
+            .then(r => r.ok ? r.json() : Promise.reject(new Error('HTTP ' + r.status)))
+            .then(accepted => waitForJob(accepted.jobId));
+    }
+
+    function waitForJob(jobId) {
+        return new Promise((resolve, reject) => {
+            const started = Date.now();
+            let timer = null;
+
+            const finish = (job) => {
+                delete state.jobWaiters[jobId];
+                clearTimeout(timer);
+                resolve(job);
+            };
+            const fail = (error) => {
+                delete state.jobWaiters[jobId];
+                clearTimeout(timer);
+                reject(error);
+            };
+            const poll = () => {
+                if (!state.jobWaiters[jobId]) return;
+                if (Date.now() - started > JOB_TIMEOUT) {
+                    fail(new Error('Zaman aşımı'));
+                    return;
+                }
+                fetch('/api/jobs/' + jobId)
+                    .then(r => r.status === 404 ? Promise.reject(new Error('İş bulunamadı')) : r.json())
+                    .then(job => {
+                        if (job.state === 'done') finish(job);
+                        else timer = setTimeout(poll, JOB_POLL_INTERVAL);
+                    })
+                    .catch(error => {
+                        // Sonuç bu arada WebSocket'ten geldiyse bekleyen kalmamıştır
+                        if (state.jobWaiters[jobId]) fail(error);
+                    });
+            };
+
+            state.jobWaiters[jobId] = finish;
+            // WebSocket bağlıyken yoklama sadece yedek
+            timer = setTimeout(poll, state.authenticated ? 3000 : JOB_POLL_INTERVAL);
+        });
+    }
+
+    // --- Sayfa Açılış Verisi ---
+
+    // Sayfa başlatıcıları ihtiyaç duydukları GET'leri kaydeder; init() hepsini
+    // tek POST /api/batch isteğiyle alır (N tur yerine bir tur)
+    function requestBootstrap(path, handler) {
+        state.bootstrap.push({ path, handler });
+    }
+
+    // Yapılandırma gövdeleri sessionStorage'da kendi ETag'leriyle yol başına
+    // saklanır; o yolun sürümü değişmediyse sunucu 304 döner ve saklanan
+    // gövde kullanılır
+    function loadBootstrap() {
+        if (state.bootstrap.length === 0) return;
+        const body = new URLSearchParams();
+        state.bootstrap.forEach(item => {
+            body.append('path', item.path);
+            const cached = JSON.parse(sessionStorage.getItem('batch:' + item.path) || 'null');
+            if (cached && cached.etag) body.append('etag', cached.etag);   // Önceki path'e ait
+        });
+
+        fetch('/api/batch', { method: 'POST', body })
+            .then(r => r.ok ? r.json() : Promise.reject(new Error('HTTP ' + r.status)))
+            .then(result => {
+                result.responses.forEach((response, i) => {
+                    const item = state.bootstrap[i];
+                    const key = 'batch:' + item.path;
+                    if (response.status === 200) {
+                        if (response.etag) {
+                            sessionStorage.setItem(key, JSON.stringify({ etag: response.etag, body: response.body }));
+                        }
+                        item.handler(response.body);
+                    } else if (response.status === 304) {
+                        const cached = JSON.parse(sessionStorage.getItem(key) || 'null');
+                        if (cached) {
+                            item.handler(cached.body);
+                        } else {
+                            fetch(item.path).then(r => r.json()).then(item.handler);
+                        }
+                    }
+                });
+            })
+            .catch(error => console.error('Sayfa verisi alınamadı:', error));
+    }
+
     // --- ARAYÜZ GÜNCELLEME FONKSİYONLARI ---
     
     function updateElement(id, value) {
@@ -156,7 +369,7 @@ document.addEventListener('DOMContentLoaded', () => {
         }, duration);
     }
 
-    function addLogEntry(logData) {
+    function addLogEntry(logData, append = false) {
         const logContainer = document.getElementById('logContainer');
         if (!logContainer) return;
         
@@ -164,19 +377,36 @@ document.addEventListener('DOMContentLoaded', () => {
         const loading = logContainer.querySelector('.loading-logs');
         if (loading) loading.remove();
 
+        // İçerik textContent ile yazılır: mesajdaki < > " karakterleri sayfayı bozmaz
         const logEntry = document.createElement('div');
         logEntry.className = `log-entry log-${logData.level.toLowerCase()}`;
-        logEntry.innerHTML = `
-            <span class="log-time">${logData.timestamp}</span>
-            <span class="log-level">${logData.level}</span>
-            <span class="log-source">${logData.source}</span>
-            <span class="log-message">${logData.message}</span>
-        `;
-        
-        logContainer.prepend(logEntry);
+        [
+            ['log-time', logData.timestamp],
+            ['log-level', logData.level],
+            ['log-source', logData.source],
+            ['log-message', logData.message]
+        ].forEach(([cls, text]) => {
+            const span = document.createElement('span');
+            span.className = cls;
+            span.textContent = text;
+            logEntry.appendChild(span);
+        });
+
+        // Tekrar özeti: aynı kayıt ilk zamandan bu yana N kez daha geldi
+        if (logData.repeat) {
+            const span = document.createElement('span');
+            span.className = 'log-repeat';
+            span.textContent = `×${logData.repeat} (ilk: ${logData.repeatFirst})`;
+            logEntry.appendChild(span);
+        }
         
-        if (state.autoScroll) {
-            logContainer.scrollTop = 0;
+        if (append) {
+            logContainer.appendChild(logEntry);
+        } else {
+            logContainer.prepend(logEntry);
+            if (state.autoScroll) {
+                logContainer.scrollTop = 0;
+            }
         }
 
         while (logContainer.children.length > 200) { // Limiti 200 yapalım
@@ -192,7 +422,7 @@ document.addEventListener('DOMContentLoaded', () => {
         if (!form) return;
 
         // Mevcut ayarları yükle
-        fetch('/api/settings').then(r => r.json()).then(settings => {
+        requestBootstrap('/api/settings', settings => {
             updateElement('deviceName', settings.deviceName);
             updateElement('tmName', settings.tmName);
             updateElement('username', settings.username);
@@ -226,7 +456,7 @@ document.addEventListener('DOMContentLoaded', () => {
         if (!form) return;
 
         // Mevcut ayarları yükle
-        fetch('/api/ntp').then(r => r.json()).then(ntp => {
+        requestBootstrap('/api/ntp', ntp => {
              updateElement('currentServer1', ntp.ntpServer1);
              updateElement('currentServer2', ntp.ntpServer2);
              document.getElementById('ntpServer1').value = ntp.ntpServer1;
@@ -236,14 +466,15 @@ document.addEventListener('DOMContentLoaded', () => {
         form.addEventListener('submit', (e) => {
             e.preventDefault();
             const formData = new FormData(form);
-            fetch('/api/ntp', { method: 'POST', body: new URLSearchParams(formData) })
-                .then(response => {
-                    if (response.ok) {
+            runUartJob('/api/ntp', new URLSearchParams(formData))
+                .then(job => {
+                    if (job.success) {
                         showMessage('NTP ayarları başarıyla gönderildi.', 'success');
                     } else {
-                        showMessage('NTP ayarları gönderilemedi.', 'error');
+                        showMessage('NTP ayarları kaydedildi, cihaz yanıt vermedi.', 'warning');
                     }
-                });
+                })
+                .catch(() => showMessage('NTP ayarları gönderilemedi.', 'error'));
         });
     }
     
@@ -252,7 +483,7 @@ document.addEventListener('DOMContentLoaded', () => {
         const form = document.getElementById('baudrateForm');
         if (!form) return;
 
-        fetch('/api/baudrate').then(r => r.json()).then(br => {
+        requestBootstrap('/api/baudrate', br => {
              updateElement('currentBaudRate', br.baudRate + ' bps');
              const radio = document.querySelector(`input[name="baud"][value="${br.baudRate}"]`);
              if (radio) radio.checked = true;
@@ -261,15 +492,16 @@ document.addEventListener('DOMContentLoaded', () => {
         form.addEventListener('submit', (e) => {
             e.preventDefault();
             const formData = new FormData(form);
-             fetch('/api/baudrate', { method: 'POST', body: new URLSearchParams(formData) })
-                .then(response => {
-                    if (response.ok) {
+             runUartJob('/api/baudrate', new URLSearchParams(formData))
+                .then(job => {
+                    if (job.success) {
                         showMessage('BaudRate başarıyla değiştirildi.', 'success');
                          setTimeout(() => location.reload(), 1000);
                     } else {
                         showMessage('BaudRate değiştirilemedi.', 'error');
                     }
-                });
+                })
+                .catch(() => showMessage('BaudRate değiştirilemedi.', 'error'));
         });
     }
     
@@ -282,8 +514,8 @@ document.addEventListener('DOMContentLoaded', () => {
         if (!firstFaultBtn) return;
         
         const fetchFault = (endpoint) => {
-            fetch(endpoint, { method: 'POST' })
-            .then(r => r.text())
+            runUartJob(endpoint)
+            .then(job => job.success ? job.response : Promise.reject(new Error('UART hatası')))
             .then(text => {
                 const emptyState = faultContent.querySelector('.empty-state');
                 if(emptyState) emptyState.remove();
@@ -308,19 +540,135 @@ document.addEventListener('DOMContentLoaded', () => {
     function initLogPage() {
         const pauseBtn = document.getElementById('pauseLogsBtn');
         const clearBtn = document.getElementById('clearLogsBtn');
+        const exportBtn = document.getElementById('exportLogsBtn');
         const autoScrollBtn = document.getElementById('autoScrollToggle');
+        const refreshBtn = document.getElementById('refreshLogsBtn');
+        const loadMoreBtn = document.getElementById('loadMoreLogsBtn');
+        const levelFilter = document.getElementById('logLevelFilter');
+        const sourceFilter = document.getElementById('logSourceFilter');
+        const searchInput = document.getElementById('logSearch');
+        const autoRefreshBtn = document.getElementById('autoRefreshToggle');
+        const refreshInterval = document.getElementById('refreshInterval');
 
         if (!pauseBtn) return;
 
+        // Arama kutusu istemci tarafında, yüklenmiş kayıtlar üzerinde çalışır
+        const applySearch = () => {
+            const term = searchInput.value.toLowerCase();
+            document.querySelectorAll('#logContainer .log-entry').forEach(el => {
+                el.style.display = !term || el.textContent.toLowerCase().includes(term) ? '' : 'none';
+            });
+        };
+
+        const updateLogStats = () => {
+            const entries = document.querySelectorAll('#logContainer .log-entry');
+            updateElement('totalLogs', entries.length);
+            updateElement('errorCount', document.querySelectorAll('#logContainer .log-error').length);
+            updateElement('warningCount', document.querySelectorAll('#logContainer .log-warn').length);
+            updateElement('lastLogUpdate', new Date().toLocaleTimeString('tr-TR'));
+        };
+
+        // Seviye/kaynak filtresi sunucuda uygulanır, sayfalama imleç ile yapılır
+        const loadLogs = (reset) => {
+            const params = new URLSearchParams({ limit: 100 });
+            if (levelFilter.value !== 'all') params.set('level', levelFilter.value);
+            if (sourceFilter.value !== 'all') params.set('source', sourceFilter.value);
+            if (!reset && state.logCursor !== null) params.set('cursor', state.logCursor);
+
+            fetch('/api/logs?' + params).then(r => r.json()).then(result => {
+                const logContainer = document.getElementById('logContainer');
+                if (reset) logContainer.innerHTML = '';
+
+                result.entries.forEach(e => addLogEntry({
+                    timestamp: e.t, level: e.l, source: e.s, message: e.m,
+                    repeat: e.r, repeatFirst: e.rf
+                }, true));
+
+                state.logCursor = result.next;
+                if (loadMoreBtn) loadMoreBtn.hidden = result.next === null;
+                applySearch();
+                updateLogStats();
+
+                // Yeni kayıtlar WebSocket üzerinden bu noktadan itibaren gelir
+                if (reset) {
+                    state.logSeq = result.latest;
+                    state.logBoot = result.boot;
+                    subscribeLogs();
+                }
+            }).catch(() => showMessage('Log kayıtları alınamadı.', 'error'));
+        };
+
+        // WebSocket "logs" frame'i: eski -> yeni sıralı kayıtlar
+        state.onLogBatch = (batch) => {
+            if (batch.reset) state.logSeq = null;  // Cihaz yeniden başladı
+            batch.entries.forEach(e => {
+                if (state.logSeq !== null && e.seq < state.logSeq) return;  // Zaten gösterildi
+                if (state.logPaused) return;
+                if (levelFilter.value !== 'all' && levelFilter.value !== e.l) return;
+                if (sourceFilter.value !== 'all' && sourceFilter.value !== e.s) return;
+                addLogEntry({ timestamp: e.t, level: e.l, source: e.s, message: e.m, repeat: e.r, repeatFirst: e.rf });
+            });
+            state.logSeq = batch.next;
+            state.logBoot = batch.boot;
+            applySearch();
+            updateLogStats();
+        };
+
+        const scheduleRefresh = () => {
+            clearInterval(state.logRefreshTimer);
+            state.logRefreshTimer = null;
+            if (autoRefreshBtn.dataset.active === 'true') {
+                state.logRefreshTimer = setInterval(() => {
+                    if (!state.logPaused) loadLogs(true);
+                }, parseInt(refreshInterval.value, 10));
+            }
+        };
+
+        refreshBtn.addEventListener('click', () => loadLogs(true));
+        if (loadMoreBtn) loadMoreBtn.addEventListener('click', () => loadLogs(false));
+        levelFilter.addEventListener('change', () => loadLogs(true));
+        sourceFilter.addEventListener('change', () => loadLogs(true));
+        searchInput.addEventListener('input', applySearch);
+
+        document.getElementById('clearFiltersBtn').addEventListener('click', () => {
+            levelFilter.value = 'all';
+            sourceFilter.value = 'all';
+            searchInput.value = '';
+            loadLogs(true);
+        });
+
+        autoRefreshBtn.addEventListener('click', () => {
+            autoRefreshBtn.dataset.active = autoRefreshBtn.dataset.active !== 'true';
+            scheduleRefresh();
+        });
+        refreshInterval.addEventListener('change', scheduleRefresh);
+
+        loadLogs(true);
+        scheduleRefresh();
+
         pauseBtn.addEventListener('click', () => {
             state.logPaused = !state.logPaused;
             pauseBtn.textContent = state.logPaused ? '▶️ Devam Ettir' : '⏸️ Duraklat';
         });
 
         clearBtn.addEventListener('click', () => {
-             document.getElementById('logContainer').innerHTML = '';
+            fetch('/api/logs/clear', { method: 'POST' }).then(response => {
+                if (response.ok) {
+                    document.getElementById('logContainer').innerHTML = '';
+                    state.logCursor = null;
+                    if (loadMoreBtn) loadMoreBtn.hidden = true;
+                    updateLogStats();
+                }
+            });
         });
 
+        if (exportBtn) {
+            // Kalıcı log arşivini (LittleFS segmentleri) indir
+            exportBtn.addEventListener('click', () => {
+                window.location.href = '/api/logs/download';
+            });
+        }
+
         autoScrollBtn.addEventListener('click', () => {
             state.autoScroll = !state.autoScroll;
             autoScrollBtn.dataset.active = state.autoScroll;
@@ -340,6 +688,7 @@ document.addEventListener('DOMContentLoaded', () => {
         initBaudRatePage();
         initFaultPage();
         initLogPage();
+        loadBootstrap();
     }
     
     init();
@@ -3,10 +3,41 @@
 
 #include <Arduino.h>
 
-bool checkSession();
-void handleUserLogin();
-void handleUserLogout();
-void refreshSession();
+class AsyncWebServerRequest;
 
-#endif
+// Oturum tablosu - her giriş kendi rastgele 128 bit token'ını alır
+// (HttpOnly "SID" çerezi). Açık adresleme, doğrusal yoklama; token zaten
+// rastgele olduğundan ilk 32 biti doğrudan hash olarak kullanılır.
+#define SESSION_SLOTS        16      // 2'nin kuvveti olmalı (maske ile indekslenir)
+#define SESSION_MAX          12      // Dolu slot sınırı - yoklama zinciri kısa kalır
+#define SESSION_TOKEN_BYTES  16
+#define SESSION_COOKIE       "SID"
+
+// İsteğin kendi çerezindeki token'ı doğrular, geçerliyse süresini uzatır
+bool checkSession(AsyncWebServerRequest* request);
+// Hex token doğrulama (WebSocket el sıkışmasındaki Cookie başlığı için)
+bool checkSessionCookie(const String& cookieHeader);
+void handleUserLogin(AsyncWebServerRequest* request);
+void handleUserLogout(AsyncWebServerRequest* request);
+
+// Süresi dolan oturumları sil - loop()'tan çağrılır
+void expireSessions();
+// Parola değişince tüm oturumları kapat
+void endAllSessions();
+int getActiveSessionCount();
 
+// WebSocket oturum bağı: el sıkışma başlığı hangi client'a ait olduğunu
+// bildirmediği için sayfa önce tek kullanımlık bilet alır, bağlantı URL'sinde
+// gönderir. Bilet kısa ömürlüdür ve alındığı oturumun token'ına çözülür.
+#define WS_TICKET_SLOTS      4
+#define WS_TICKET_TTL        10000   // ms
+
+void handleWsTicket(AsyncWebServerRequest* request);
+// Bileti harcar; geçerliyse bağlı oturumun token'ını yazar
+bool redeemWsTicket(const char* hex, size_t length, uint8_t* token);
+// Oturum hâlâ açık mı (süresini uzatmaz - WebSocket trafiği oturumu canlı tutmaz)
+bool isSessionActive(const uint8_t* token);
+// Her oturum kapanışında artar; WebSocket tarafı değişince hemen yeniden doğrular
+uint32_t getSessionGeneration();
+
+#endif
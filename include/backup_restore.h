@@ -3,13 +3,18 @@
 
 #include <Arduino.h>
 
+class AsyncWebServerRequest;
+
 // Function declarations
 String exportSettingsToJSON();
 bool importSettingsFromJSON(const String& jsonData);
 bool saveBackupToFile(const String& filename);
 bool loadBackupFromFile(const String& filename);
-void handleBackupDownload();
-void handleBackupUpload();
+void handleBackupDownload(AsyncWebServerRequest* request);
+void handleBackupUploadData(AsyncWebServerRequest* request, const String& filename,
+                            size_t index, uint8_t* data, size_t len, bool final);
+void handleBackupUpload(AsyncWebServerRequest* request);
+void checkPendingRestart();
 void createAutomaticBackup();
 
 #endif // BACKUP_RESTORE_H
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef CHUNKED_RESPONSE_H
+#define CHUNKED_RESPONSE_H
+
+#include <Arduino.h>
+#include "json_writer.h"
+#include "http_metrics.h"
+
+class AsyncWebServerRequest;
+
+#define CHUNK_BUFFER_SIZE  1024   // Sabit parça tamponu - tek step() çıktısı buna sığmalı
+
+// Chunked yanıtı istendikçe üreten kaynak. Sunucu gönderim penceresi açıldıkça
+// fill() çağırır; tampon boşaldıkça step() bir parça (ör. bir log kaydı) üretir.
+// Bellek, yanıt boyundan bağımsız olarak CHUNK_BUFFER_SIZE'dır. Tampona
+// sığmayan parça üreticiyi durdurur: yanıt o noktada kesilir, hata loglanır.
+class ChunkedSource : public Print {
+public:
+    ChunkedSource();
+    // Gönderilen bayt, kaynağı oluşturan rotanın ölçümüne yazılır
+    virtual ~ChunkedSource() { addHttpRouteBytes(route, sent); }
+    
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* data, size_t size) override;
+    
+    // 0 dönerse yanıt biter
+    size_t fill(uint8_t* buffer, size_t maxLen);
+    // Başka bir kaynağın içine aktarılan kaynak baytlarını kendisi saymaz
+    void detachMetrics() { route = NULL; }
+    // Yazılan parça tampona sığmadı
+    bool overflowed() const { return overflow; }
+    
+protected:
+    // Bir parça yaz; son parçadan sonra false döner
+    virtual bool step() = 0;
+    
+private:
+    uint8_t staging[CHUNK_BUFFER_SIZE];
+    size_t length;
+    size_t offset;
+    bool finished;
+    bool overflow;
+    HttpRouteMetrics* route;
+    size_t sent;
+};
+
+// Tek parçalık JSON yanıtı - handler json'a yazar, sendJson() gönderir.
+// Gövde tek seferde yazıldığı için CHUNK_BUFFER_SIZE'a sığmalı (sığmazsa
+// sendJson boş 200 yerine 500 döner); büyük ya da değişken boylu gövdeler
+// JsonStepResponse kullanır.
+class JsonResponse : public ChunkedSource {
+public:
+    JsonWriter json;
+    
+    JsonResponse() : json(*this) {}
+    
+protected:
+    bool step() override { return false; }
+};
+
+// Adım adım JSON yazıcı: her çağrıda bir parça yazar (index 0'dan artar),
+// son parçada false döner
+typedef bool (*JsonStepWriter)(JsonWriter& json, uint16_t index);
+
+// Gövdesi JsonStepWriter ile parça parça üretilen JSON yanıtı
+class JsonStepResponse : public ChunkedSource {
+public:
+    explicit JsonStepResponse(JsonStepWriter writer) : json(*this), writer(writer), index(0) {}
+    
+protected:
+    bool step() override { return writer(json, index++); }
+    
+private:
+    JsonWriter json;
+    JsonStepWriter writer;
+    uint16_t index;
+};
+
+// source'un sahipliği yanıta geçer
+void sendChunked(AsyncWebServerRequest* request, const char* contentType, ChunkedSource* source,
+                 int code = 200, const char* disposition = NULL);
+void sendJson(AsyncWebServerRequest* request, JsonResponse* body, int code = 200);
+void sendJsonSteps(AsyncWebServerRequest* request, JsonStepWriter writer, int code = 200);
+// Adım adım yazıcının tüm parçalarını sırayla yaz (akış dışı hedefler için)
+void writeJsonSteps(JsonWriter& json, JsonStepWriter writer);
+// {"error":"..."}
+void sendJsonError(AsyncWebServerRequest* request, int code, const char* message);
+// {"success":...,"message":"..."}
+void sendJsonResult(AsyncWebServerRequest* request, int code, bool success, const char* message);
+
+#endif // CHUNKED_RESPONSE_H
@@ -6,5 +6,9 @@
 String sha256(const String& data, const String& salt);
 String generateSalt(int length = 16);
 bool isPasswordStrong(const String& password);
+// Gizli değerler (oturum token'ı, WebSocket bileti) için rastgele bayt.
+// Kart sadece Ethernet kullanır; Wi-Fi/BT kapalıyken esp_random tek başına
+// sözde rastgeledir, üretim sırasında SAR ADC gürültü kaynağı açılır.
+void fillSecureRandom(uint8_t* buffer, size_t length);
 
 #endif
\ No newline at end of file
@@ -0,0 +1,42 @@
+#ifndef HTTP_METRICS_H
+#define HTTP_METRICS_H
+
+#include <Arduino.h>
+#include "json_writer.h"
+
+// Rota başına HTTP ölçümleri - istek sayısı, durum kodu dağılımı, gönderilen
+// gövde baytı ve esp_timer (µs) ile ölçülen istek süresi histogramı (handler
+// başlangıcından yanıt bitip bağlantı kapanana kadar).
+// Tüm güncellemeler async_tcp task'ında yapılır, kilit gerekmez.
+#define HTTP_METRICS_MAX_ROUTES   40
+#define HTTP_LATENCY_BUCKETS      16   // Kova 0: < 64 µs, kova i: 32·2^i µs'den itibaren
+#define HTTP_LATENCY_MIN_SHIFT    6    // 2^6 = 64 µs
+
+struct HttpRouteMetrics {
+    const char* route;
+    uint8_t method;
+    uint32_t count;
+    uint32_t status[5];                      // 1xx..5xx
+    uint32_t bytes;                          // Gövde baytı (akışlar ve gömülü dosyalar)
+    uint64_t totalUs;
+    uint32_t maxUs;
+    uint32_t latency[HTTP_LATENCY_BUCKETS];
+};
+
+// Tablo doluysa NULL döner (rota yine çalışır, sadece ölçülmez)
+HttpRouteMetrics* registerHttpRouteMetrics(const char* route, uint8_t method);
+
+// Handler'ı saran koddan çağrılır; begin başlangıç zamanını döner.
+// endHttpHandler handler dönünce, endHttpRequest bağlantı kapanınca.
+int64_t beginHttpRequest(HttpRouteMetrics* route);
+void endHttpHandler();
+void endHttpRequest(HttpRouteMetrics* route, int64_t startUs, int statusCode);
+
+// O an handler'ı çalışan rota (handler dışında NULL)
+HttpRouteMetrics* activeHttpRoute();
+void addHttpRouteBytes(HttpRouteMetrics* route, size_t bytes);
+
+// JsonStepWriter: her çağrıda bir rota
+bool writeHttpMetricsJson(JsonWriter& json, uint16_t index);
+
+#endif // HTTP_METRICS_H
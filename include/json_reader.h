@@ -0,0 +1,82 @@
+#ifndef JSON_READER_H
+#define JSON_READER_H
+
+#include <Arduino.h>
+
+// Akış tabanlı JSON okuyucu - veri parça parça beslenir, belge hiçbir
+// zaman bütün olarak bellekte tutulmaz. Sözdizimi her baytta denetlenir;
+// ilk hatada okuma durur. Bellek sabittir: tek bir token ve her seviye
+// için bir anahtar.
+#define JSON_READER_MAX_DEPTH   6
+#define JSON_READER_MAX_KEY     32
+#define JSON_READER_MAX_TOKEN   128
+
+enum JsonReaderType : uint8_t {
+    JSON_READER_STRING,
+    JSON_READER_NUMBER,
+    JSON_READER_BOOL,
+    JSON_READER_NULL
+};
+
+class JsonReader {
+public:
+    JsonReader();
+    virtual ~JsonReader() {}
+
+    void reset();
+    // false: sözdizimi hatası veya sınır aşımı, sonraki veriler yok sayılır
+    bool feed(const uint8_t* data, size_t length);
+    // Belge eksiksiz kapandı mı
+    bool finish();
+    bool failed() const { return error != NULL; }
+    const char* errorMessage() const { return error ? error : ""; }
+
+protected:
+    // Bildirilen değerin yolu: depth() kadar seviye, her seviyedeki anahtar
+    // (dizi elemanlarında boş). Örn. network.localIP -> depth 2.
+    uint8_t depth() const { return level; }
+    const char* key(uint8_t index) const { return keys[index]; }
+
+    // Nesne açılırken (yol, nesnenin kendi yolu) ve her skaler değerde
+    virtual void onObjectStart() {}
+    virtual void onValue(JsonReaderType type, const char* text, size_t length) = 0;
+
+private:
+    enum State : uint8_t {
+        READ_VALUE,
+        READ_VALUE_OR_END,   // '[' sonrası
+        READ_KEY_OR_END,     // '{' sonrası
+        READ_KEY,            // nesnede ',' sonrası
+        READ_COLON,
+        READ_AFTER_VALUE,
+        READ_STRING,
+        READ_ESCAPE,
+        READ_UNICODE,
+        READ_LITERAL,
+        READ_DONE
+    };
+
+    State state;
+    bool stringIsKey;
+    uint8_t level;
+    char stack[JSON_READER_MAX_DEPTH];
+    char keys[JSON_READER_MAX_DEPTH][JSON_READER_MAX_KEY + 1];
+    char token[JSON_READER_MAX_TOKEN + 1];
+    size_t tokenLength;
+    uint16_t unicode;
+    uint8_t unicodeDigits;
+    uint16_t highSurrogate;
+    const char* error;
+
+    bool step(char c);
+    bool beginValue(char c);
+    bool endValue();
+    bool endString();
+    bool endLiteral();
+    bool closeContainer(char open);
+    bool append(char c);
+    bool appendCodepoint(uint32_t cp);
+    bool fail(const char* message);
+};
+
+#endif // JSON_READER_H
@@ -0,0 +1,54 @@
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <Arduino.h>
+
+// Akış tabanlı JSON yazıcı - çıktıyı doğrudan bir Print hedefine yazar,
+// ara String oluşturmaz. Anahtar/değer dizelerini JSON kurallarına göre
+// kaçışlar (tırnak, ters bölü, kontrol karakterleri).
+class JsonWriter {
+public:
+    explicit JsonWriter(Print& out);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    void key(const char* name);
+
+    void value(const char* str);
+    void value(const String& str);
+    void value(long number);
+    void value(unsigned long number);
+    void value(int number) { value((long)number); }
+    void value(unsigned int number) { value((unsigned long)number); }
+    void value(bool flag);
+    void valueNull();
+    // Ham değer: çağıran, hazır JSON'u doğrudan Print hedefine yazar
+    void beginRawValue() { separator(); }
+    void rawValue(const char* json, size_t length) {
+        separator();
+        out.write((const uint8_t*)json, length);
+    }
+
+    // key + value kısayolu
+    template <typename T>
+    void field(const char* name, const T& v) {
+        key(name);
+        value(v);
+    }
+
+private:
+    Print& out;
+    uint8_t depth;
+    uint32_t hasItems;   // Her seviye için "virgül gerekli" biti
+    bool afterKey;
+
+    void separator();
+    void open(char c);
+    void close(char c);
+    void writeEscaped(const char* str, size_t length);
+};
+
+#endif // JSON_WRITER_H
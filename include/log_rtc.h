@@ -0,0 +1,22 @@
+#ifndef LOG_RTC_H
+#define LOG_RTC_H
+
+#include <Arduino.h>
+#include "log_system.h"
+
+// Yeniden başlatmaya dayanıklı log halkası - RTC yavaş belleğinde
+// (RTC_NOINIT_ATTR) tutulur, reset sonrası açılışta geri okunur.
+#define RTC_LOG_MAGIC        0x52544C32   // "RTL2" - kayıt düzeni değişince artar
+#define RTC_LOG_CAPACITY     200          // 20 byte/kayıt -> 4 KB
+#define RTC_LOG_ARG_BYTES    7            // Paketlenmiş argümanların sığan başı
+
+// Önceki çalışmadan kalan halkayı doğrula, geçerli kayıt sayısını döndür
+uint32_t beginRtcLog();
+// index 0 = en eski kayıt. Sağlaması tutmayan kayıtlar için false
+bool readRtcLogEntry(uint32_t index, LogEntry& out);
+// Halkayı bu çalışma için sıfırla
+void resetRtcLog();
+void appendRtcLog(const LogEntry& entry);
+const char* resetReasonToString();
+
+#endif // LOG_RTC_H
@@ -0,0 +1,30 @@
+#ifndef LOG_STORAGE_H
+#define LOG_STORAGE_H
+
+#include <Arduino.h>
+
+// Kalıcı log deposu - LittleFS üzerinde sabit boyutlu segment dosyaları
+#define LOG_STORAGE_DIR          "/logs"
+#define LOG_SEGMENT_SIZE         32768   // Segment başına en fazla byte
+#define LOG_SEGMENT_COUNT        16      // Saklanacak en fazla segment sayısı
+#define LOG_FLUSH_BLOCK_SIZE     4096    // Flash sayfası/LittleFS blok boyutu
+#define LOG_FLUSH_HIGH_WATER     3072    // Bu doluluğa gelince hemen yaz
+#define LOG_FLUSH_INTERVAL       60000   // En geç bu sürede bir yaz (ms)
+
+struct LogStorageStats {
+    uint32_t firstSegment;
+    uint32_t currentSegment;
+    uint32_t segmentCount;
+    uint32_t currentSegmentSize;
+    uint32_t bytesWritten;
+    uint32_t flushCount;
+    uint32_t droppedLines;
+};
+
+void initLogStorage();
+void appendLogStorage(const char* line, size_t length);
+void flushLogStorage();
+LogStorageStats getLogStorageStats();
+String getLogSegmentPath(uint32_t segment);
+
+#endif // LOG_STORAGE_H
@@ -2,6 +2,7 @@
 #define LOG_SYSTEM_H
 
 #include <Arduino.h>
+#include "log_templates.h"
 
 enum LogLevel {
     ERROR = 0,
@@ -11,23 +12,166 @@ enum LogLevel {
     SUCCESS = 4
 };
 
+// Log kaynakları - çalışma zamanı eşik tablosu bu sırayla indekslenir.
+// Yeni kaynak eklenirse log_system.cpp'deki isim tablosu da güncellenmeli.
+enum LogSource : uint8_t {
+    LOG_SRC_SYSTEM,
+    LOG_SRC_ETH,
+    LOG_SRC_NET,
+    LOG_SRC_UART,
+    LOG_SRC_TIME,
+    LOG_SRC_NTP,
+    LOG_SRC_AUTH,
+    LOG_SRC_POLICY,
+    LOG_SRC_WS,
+    LOG_SRC_WEB,
+    LOG_SRC_BACKUP,
+    LOG_SRC_RESTORE,
+    LOG_SRC_SETTINGS,
+    LOG_SRC_MDNS,
+    LOG_SOURCE_COUNT
+};
+
+// Önem sırası (küçük = daha önemli). SUCCESS, INFO ile aynı sıradadır.
+#define LOG_RANK_ERROR  0
+#define LOG_RANK_WARN   1
+#define LOG_RANK_INFO   2
+#define LOG_RANK_DEBUG  3
+
+// Derleme zamanı alt sınırı: bunun altındaki çağrılar (argümanlarıyla
+// birlikte) hiç derlenmez. platformio.ini'de -DLOG_COMPILE_LEVEL=3 ile
+// DEBUG logları açılabilir.
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_RANK_INFO
+#endif
+
+// Varsayılan çalışma zamanı eşiği (kaynak başına /api/logs/levels ile değişir)
+#define LOG_DEFAULT_THRESHOLD LOG_RANK_INFO
+
+// Halka arabellek kapasitesi (kayıt sayısı). Çalışma zamanında değiştirilebilir,
+// "log-config" NVS alanında saklanır. PSRAM yoksa SRAM sınırına kırpılır.
+#define LOG_CAPACITY_DEFAULT_PSRAM  8192   // 64 byte/kayıt -> 512 KB
+#define LOG_CAPACITY_DEFAULT_SRAM   200
+#define LOG_CAPACITY_SRAM_MAX       400
+#define LOG_CAPACITY_MIN            50
+#define LOG_CAPACITY_MAX            32768
+
+// Kayıt başına paketlenmiş argüman alanı (LogEntry toplam 64 byte olacak şekilde)
+#define LOG_ARG_BYTES 45
+
+// Aynı kaynak/seviye/şablondan art arda gelen kayıtlar bu süre boyunca
+// tek bir özet kayıtta toplanır (ms)
+#define LOG_REPEAT_WINDOW 60000
+
+// Paketlenmiş argüman etiketleri
+#define LOG_ARG_INT   'i'  // int32, 4 byte
+#define LOG_ARG_UINT  'u'  // uint32, 4 byte
+#define LOG_ARG_STR   's'  // uzunluk + byte'lar (bit 7: kırpıldı)
+#define LOG_ARG_IPV4  'a'  // 4 byte
+
+#define LOG_ARG_STR_TRUNCATED 0x80
+
+// Sabit boyutlu kayıt: metin yerine şablon id'si ve ham argümanlar saklanır,
+// heap kullanılmaz. Metin formatLogMessage() ile okunurken üretilir.
 struct LogEntry {
-    String timestamp;
-    String message;
-    LogLevel level;
-    String source;
-    unsigned long millis_time;
+    uint32_t millis_time;
+    uint32_t epoch;             // Gerçek zaman (saat ayarlı değilse 0)
+    uint32_t firstMillis;       // Özet kayıtta ilk tekrarın zamanı
+    uint16_t repeatCount;       // Özet kayıtta toplanan tekrar sayısı (0 = tekil kayıt)
+    uint16_t templateId;        // LogTemplateId
+    uint8_t level;              // LogLevel
+    uint8_t source;             // LogSource
+    uint8_t argLength;
+    uint8_t args[LOG_ARG_BYTES];
+};
+
+// Argümanlar kayda kopyalanmadan önce burada toplanır
+struct LogArgPacker {
+    uint8_t data[LOG_ARG_BYTES];
+    uint8_t length;
+
+    LogArgPacker() : length(0) {}
 };
 
-extern LogEntry logs[50];
 extern int logIndex;
 extern int totalLogs;
+extern uint32_t logSequence;  // Şimdiye kadar eklenen kayıt sayısı = sonraki kaydın id'si
+extern uint32_t logBootId;    // Her açılışta rastgele - seq'lerin hangi açılışa ait olduğu
+
+extern uint8_t logThresholds[LOG_SOURCE_COUNT];
+
+inline uint8_t logLevelRank(LogLevel level) {
+    return level == SUCCESS ? LOG_RANK_INFO : (uint8_t)level;
+}
+
+// Kaynak eşiği bu seviyeye izin veriyor mu? Makrolar argümanları
+// paketlemeden önce bunu kontrol eder.
+inline bool logEnabled(LogSource source, LogLevel level) {
+    return logLevelRank(level) <= logThresholds[source];
+}
+
+void packLogArg(LogArgPacker& packer, long value);
+void packLogArg(LogArgPacker& packer, unsigned long value);
+void packLogArg(LogArgPacker& packer, const char* value);
+void packLogArg(LogArgPacker& packer, const IPAddress& value);
+inline void packLogArg(LogArgPacker& packer, int value) { packLogArg(packer, (long)value); }
+inline void packLogArg(LogArgPacker& packer, unsigned int value) { packLogArg(packer, (unsigned long)value); }
+inline void packLogArg(LogArgPacker& packer, const String& value) { packLogArg(packer, value.c_str()); }
+
+void commitLogEvent(LogLevel level, LogSource source, LogTemplateId tpl, const LogArgPacker& args);
+
+// Argümanları sırayla paketleyip kaydı ekler. Sığmayan argümanlar kırpılır.
+template <typename... Args>
+void logEvent(LogLevel level, LogSource source, LogTemplateId tpl, const Args&... args) {
+    LogArgPacker packer;
+    int unpack[] = {0, (packLogArg(packer, args), 0)...};
+    (void)unpack;
+    commitLogEvent(level, source, tpl, packer);
+}
+
+#define LOG_AT_LEVEL(level, source, tpl, ...) \
+    do { if (logEnabled((source), (level))) logEvent((level), (source), (tpl), ##__VA_ARGS__); } while (0)
+
+#define LOGE(source, tpl, ...) LOG_AT_LEVEL(ERROR, source, tpl, ##__VA_ARGS__)
+
+#if LOG_COMPILE_LEVEL >= LOG_RANK_WARN
+#define LOGW(source, tpl, ...) LOG_AT_LEVEL(WARN, source, tpl, ##__VA_ARGS__)
+#else
+#define LOGW(source, tpl, ...) do { } while (0)
+#endif
+
+#if LOG_COMPILE_LEVEL >= LOG_RANK_INFO
+#define LOGI(source, tpl, ...) LOG_AT_LEVEL(INFO, source, tpl, ##__VA_ARGS__)
+#define LOGS(source, tpl, ...) LOG_AT_LEVEL(SUCCESS, source, tpl, ##__VA_ARGS__)
+#else
+#define LOGI(source, tpl, ...) do { } while (0)
+#define LOGS(source, tpl, ...) do { } while (0)
+#endif
+
+#if LOG_COMPILE_LEVEL >= LOG_RANK_DEBUG
+#define LOGD(source, tpl, ...) LOG_AT_LEVEL(DEBUG, source, tpl, ##__VA_ARGS__)
+#else
+#define LOGD(source, tpl, ...) do { } while (0)
+#endif
 
 void initLogSystem();
-void addLog(const String& msg, LogLevel level, const String& source);
+size_t formatLogMessage(const LogEntry& entry, char* out, size_t size);
+size_t formatLogTimestamp(const LogEntry& entry, char* out, size_t size);
+size_t formatLogFirstTimestamp(const LogEntry& entry, char* out, size_t size);
+void flushLogRepeats(bool force);
 String logLevelToString(LogLevel level);
+int logLevelFromString(const String& name);
+const char* logSourceToString(LogSource source);
+int logSourceFromString(const String& name);
+bool setLogThreshold(LogSource source, uint8_t rank);
+bool getLogEntry(uint32_t id, LogEntry& out);
+uint32_t getLogCapacity();
+bool isLogBufferInPsram();
+bool setLogCapacity(uint32_t capacity);
+uint32_t getOldestLogId();
 void clearLogs();
 String getFormattedTimestamp();
 String getFormattedTimestampFallback();
+uint32_t getSerialLogDropCount();
 
 #endif
\ No newline at end of file
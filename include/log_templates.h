@@ -0,0 +1,136 @@
+#ifndef LOG_TEMPLATES_H
+#define LOG_TEMPLATES_H
+
+// Log mesaj şablonları. Kayıtlarda metin yerine şablon id'si ve
+// paketlenmiş argümanlar saklanır; metin sadece okunurken üretilir.
+// "{}" sıradaki argümanı, "{x}" sıradaki sayıyı onaltılık olarak yazar.
+// Yeni şablonlar listenin sonuna eklenmeli: id'ler RTC/flash kayıtlarında
+// saklanabilir.
+#define LOG_TEMPLATE_LIST(X) \
+    X(LT_TEXT,                      "{}") \
+    /* Sistem */ \
+    X(LT_LOG_STARTED,               "Log sistemi başlatıldı.") \
+    X(LT_LOG_CLEARED,               "Log kayıtları temizlendi.") \
+    X(LT_LOG_STORAGE_READY,         "Kalıcı log deposu hazır - segment #{} ({} byte)") \
+    X(LT_SYSTEM_STARTED,            "🚀 Sistem başlatıldı") \
+    X(LT_SYSTEM_STATION,            "📍 Trafo Merkezi: {}") \
+    X(LT_SYSTEM_LOW_HEAP,           "⚠️ Düşük bellek: {}") \
+    X(LT_SYSTEM_CRITICAL_HEAP,      "❌ Kritik bellek seviyesi, yeniden başlatılıyor: {}") \
+    X(LT_MDNS_STARTED,              "✅ mDNS başlatıldı: {}.local") \
+    X(LT_MDNS_FAILED,               "❌ mDNS başlatılamadı") \
+    /* Ethernet / ağ */ \
+    X(LT_NET_CONFIG_READY,          "Network yapılandırması hazır") \
+    X(LT_ETH_STARTING,              "Ethernet başlatılıyor...") \
+    X(LT_ETH_STATIC_IP,             "✅ Statik IP: {}") \
+    X(LT_ETH_STATIC_IP_FAILED,      "❌ Statik IP atanamadı!") \
+    X(LT_ETH_DHCP,                  "DHCP ile IP alınıyor...") \
+    X(LT_ETH_ACTIVE,                "✅ Ethernet aktif") \
+    X(LT_ETH_OK,                    "Ethernet OK: {}") \
+    X(LT_ETH_CONNECTED,             "✅ Ethernet bağlandı") \
+    X(LT_ETH_DISCONNECTED,          "❌ Ethernet kesildi") \
+    X(LT_ETH_NO_CABLE,              "⚠️ Ethernet kablosu bağlı değil") \
+    X(LT_ETH_IP,                    "IP Adresi: {}") \
+    X(LT_ETH_GATEWAY,               "Gateway: {}") \
+    X(LT_ETH_SUBNET,                "Subnet: {}") \
+    X(LT_ETH_DNS,                   "DNS: {}") \
+    X(LT_ETH_MAC,                   "MAC: {}") \
+    X(LT_ETH_SPEED,                 "Link Hızı: {} Mbps") \
+    X(LT_ETH_DUPLEX,                "Duplex: {}") \
+    /* Kimlik doğrulama / ayarlar */ \
+    X(LT_AUTH_SESSION_TIMEOUT,      "Oturum zaman aşımı") \
+    X(LT_AUTH_LOCKED_OUT,           "Çok fazla başarısız giriş denemesi. Kalan süre: {}s") \
+    X(LT_AUTH_INPUT_TOO_LONG,       "Aşırı uzun giriş denemesi") \
+    X(LT_AUTH_LOGIN_OK,             "✅ Başarılı giriş: {}") \
+    X(LT_AUTH_LOGIN_FAILED,         "❌ Başarısız giriş denemesi (#{}): {}") \
+    X(LT_AUTH_LOCKOUT,              "🔒 IP adresi {} saniye kilitlendi") \
+    X(LT_AUTH_LOGOUT,               "🚪 Çıkış yapıldı") \
+    X(LT_AUTH_PASSWORD_WRONG,       "❌ Parola değiştirme başarısız: Yanlış mevcut parola") \
+    X(LT_AUTH_PASSWORD_CHANGED,     "✅ Parola başarıyla değiştirildi") \
+    X(LT_POLICY_LOADED,             "Parola politikası yüklendi") \
+    X(LT_SETTINGS_LOADED,           "Ayarlar yüklendi") \
+    X(LT_SETTINGS_PASSWORD_CHANGED, "Şifre değiştirildi") \
+    X(LT_SETTINGS_SAVED,            "Ayarlar kaydedildi") \
+    /* Yedekleme / geri yükleme */ \
+    X(LT_BACKUP_EXPORTED,           "✅ Ayarlar JSON formatında export edildi") \
+    X(LT_BACKUP_FILE_CREATE_FAILED, "❌ Backup dosyası oluşturulamadı: {}") \
+    X(LT_BACKUP_FILE_SAVED,         "✅ Backup dosyası kaydedildi: {}") \
+    X(LT_BACKUP_DOWNLOADED,         "📥 Backup indirildi") \
+    X(LT_BACKUP_OLD_REMOVED,        "🗑️ Eski backup silindi: {}") \
+    X(LT_BACKUP_AUTO_CREATED,       "💾 Otomatik backup oluşturuldu") \
+    X(LT_RESTORE_PARSE_ERROR,       "❌ JSON parse hatası: {}") \
+    X(LT_RESTORE_VERSION_MISMATCH,  "⚠️ Uyumsuz backup versiyonu: {}") \
+    X(LT_RESTORE_IMPORTED,          "✅ Ayarlar başarıyla import edildi") \
+    X(LT_RESTORE_RESTART_REQUIRED,  "⚠️ Yeniden başlatma gerekli") \
+    X(LT_RESTORE_IMPORT_FAILED,     "❌ Ayarlar import edilemedi") \
+    X(LT_RESTORE_FILE_NOT_FOUND,    "❌ Backup dosyası bulunamadı: {}") \
+    X(LT_RESTORE_UPLOAD_STARTED,    "📤 Backup yükleme başladı: {}") \
+    /* NTP / zaman */ \
+    X(LT_NTP_REQUEST_FAILED,        "❌ dsPIC33EP'den NTP bilgisi alınamadı") \
+    X(LT_NTP_RECEIVED,              "✅ NTP sunucuları dsPIC33EP'den alındı: {}, {}") \
+    X(LT_NTP_BAD_RESPONSE,          "❌ Geçersiz NTP yanıt formatı: {}") \
+    X(LT_NTP_SERVER_EMPTY,          "NTP sunucu adresi boş") \
+    X(LT_NTP_ACKED,                 "✅ NTP ayarları dsPIC33EP tarafından onaylandı") \
+    X(LT_NTP_NO_RESPONSE,           "⚠️ NTP ayarları için yanıt alınamadı") \
+    X(LT_NTP_LOADED,                "✅ NTP ayarları yüklendi") \
+    X(LT_NTP_INVALID_PRIMARY,       "Geçersiz birincil NTP sunucu") \
+    X(LT_NTP_INVALID_SECONDARY,     "Geçersiz ikincil NTP sunucu") \
+    X(LT_NTP_SAVED,                 "✅ NTP ayarları kaydedildi") \
+    X(LT_NTP_DEFAULTS,              "⚠️ Kayıtlı NTP ayarı bulunamadı, varsayılanlar kullanılıyor") \
+    X(LT_NTP_STARTED,               "✅ NTP Handler başlatıldı") \
+    X(LT_NTP_RESET,                 "NTP ayarları sıfırlandı") \
+    X(LT_TIME_SYSTEM_UPDATED,       "Sistem saati güncellendi") \
+    X(LT_TIME_BAD_FORMAT,           "Geçersiz zaman formatı: {}") \
+    X(LT_TIME_REQUEST_FAILED,       "❌ dsPIC'ten zaman bilgisi alınamadı") \
+    X(LT_TIME_SYNCED,               "✅ Zaman senkronize edildi: {} {}") \
+    X(LT_TIME_SYNC_LOST,            "⚠️ Zaman senkronizasyonu kaybedildi") \
+    X(LT_TIME_SYNC_STATS,           "Senkronizasyon: {}, toplam {}, son senkronizasyon {} sn önce") \
+    /* UART / dsPIC */ \
+    X(LT_DSPIC_RESPONSE,            "dsPIC33EP yanıtı: {}") \
+    X(LT_UART_STARTED,              "✅ UART başlatıldı - TX2: IO{}, RX2: IO{}, Baud: {}") \
+    X(LT_UART_BAUD_INVALID,         "Geçersiz baudrate kodu: {}") \
+    X(LT_UART_BAUD_SENT,            "dsPIC33EP'ye baudrate kodu gönderildi: {}") \
+    X(LT_UART_BAUD_ACKED,           "✅ Baudrate kodu dsPIC33EP tarafından alındı") \
+    X(LT_UART_NO_RESPONSE,          "❌ dsPIC33EP'den yanıt alınamadı") \
+    X(LT_UART_FAULT_QUERY,          "Arıza sorgu komutu: {}") \
+    X(LT_UART_FAULT_RECEIVED,       "Arıza kaydı alındı: {}...") \
+    X(LT_UART_SILENT,               "⚠️ UART 5 dakikadır sessiz") \
+    X(LT_UART_RESTARTING,           "🔄 UART yeniden başlatılıyor...") \
+    X(LT_UART_TEST_STARTED,         "UART bağlantı testi...") \
+    X(LT_UART_TEST_OK,              "✅ UART testi başarılı: {}") \
+    X(LT_UART_TEST_FAILED,          "❌ UART testi başarısız") \
+    X(LT_UART_FRAME_TOO_LARGE,      "❌ Frame verisi çok büyük: {}") \
+    X(LT_UART_FRAME_SENT,           "📤 Frame gönderildi - Cmd: 0x{x}, Len: {}") \
+    X(LT_UART_FRAME_RECEIVED,       "✅ Frame alındı - Cmd: 0x{x}, Len: {}") \
+    X(LT_UART_CHECKSUM_ERROR,       "❌ Checksum hatası! Beklenen: 0x{x}, Alınan: 0x{x}") \
+    X(LT_UART_FRAME_TIMEOUT,        "⏱️ Frame okuma timeout") \
+    X(LT_UART_TIME_RECEIVED,        "✅ Zaman bilgisi alındı: {}") \
+    X(LT_UART_NTP_SENT,             "✅ NTP config gönderildi") \
+    X(LT_UART_FIRST_FAULT,          "✅ İlk arıza kaydı alındı") \
+    X(LT_UART_NEXT_FAULT,           "✅ Sonraki arıza kaydı alındı") \
+    X(LT_UART_LINK_RESTORED,        "✅ UART bağlantısı düzeldi") \
+    X(LT_UART_PING_FAILED,          "⚠️ UART ping başarısız (#{})") \
+    X(LT_UART_LINK_LOST,            "❌ UART bağlantısı kayıp") \
+    /* Web / WebSocket */ \
+    X(LT_WEB_STARTED,               "✅ Web sunucu başlatıldı") \
+    X(LT_WS_STARTED,                "✅ WebSocket server başlatıldı (Port {})") \
+    X(LT_WS_CLIENT_CONNECTED,       "WebSocket client #{} bağlandı: {}") \
+    X(LT_WS_CLIENT_DISCONNECTED,    "WebSocket client #{} bağlantısı kesildi") \
+    X(LT_WS_CLIENT_TIMEOUT,         "WebSocket client #{} timeout") \
+    X(LT_WS_PARSE_ERROR,            "WebSocket JSON parse hatası") \
+    X(LT_WS_ERROR,                  "WebSocket hatası") \
+    X(LT_LOG_RECOVERED,             "⏪ Yeniden başlatma öncesinden {} kayıt kurtarıldı (reset nedeni: {})") \
+    X(LT_UART_JOB_QUEUE_FULL,       "⚠️ UART iş kuyruğu dolu (iş tipi {})") \
+    X(LT_STATUS_SNAPSHOT_OVERFLOW,  "⚠️ Durum görüntüsü {} byte'a sığmadı") \
+    X(LT_WS_CLIENT_OVERFLOW,        "⚠️ WebSocket client #{} kuyruğu taştı ({} mesaj düşürüldü), bağlantı kesiliyor") \
+    X(LT_WEB_CHUNK_OVERFLOW,        "❌ Yanıt parçası {} byte'lık tampona sığmadı, yanıt kesildi") \
+    X(LT_WS_SESSION_ENDED,          "WebSocket client #{} oturumu geçersiz, bağlantı kesiliyor") \
+    X(LT_WS_FRAME_TOO_LARGE,        "⚠️ WebSocket mesajı ({} byte) frame sınırını ({}) aşıyor, gönderilmedi")
+
+enum LogTemplateId : uint16_t {
+#define LOG_TEMPLATE_ENUM(id, format) id,
+    LOG_TEMPLATE_LIST(LOG_TEMPLATE_ENUM)
+#undef LOG_TEMPLATE_ENUM
+    LOG_TEMPLATE_COUNT
+};
+
+#endif // LOG_TEMPLATES_H
@@ -25,7 +25,7 @@ void initNTPHandler();
 void processReceivedData();
 bool loadNTPSettings();
 bool saveNTPSettings(const String& server1, const String& server2, int timezone);
-void sendNTPConfigToBackend();
+bool sendNTPConfigToBackend();
 String formatDate(const String& dateStr);
 String formatTime(const String& timeStr);
 void parseTimeData(const String& data);
@@ -3,6 +3,8 @@
 
 #include <Arduino.h>
 
+class AsyncWebServerRequest;
+
 // Password policy structure
 struct PasswordPolicy {
     bool firstLoginPasswordChange;
@@ -26,7 +28,7 @@ bool isPasswordInHistory(const String& password);
 void addPasswordToHistory(const String& passwordHash, const String& salt);
 bool isPasswordExpired();
 bool mustChangePassword();
-void handlePasswordChangePage();
-void handlePasswordChangeAPI();
+void handlePasswordChangePage(AsyncWebServerRequest* request);
+void handlePasswordChangeAPI(AsyncWebServerRequest* request);
 
 #endif // PASSWORD_POLICY_H
\ No newline at end of file
@@ -0,0 +1,36 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <Arduino.h>
+
+// İstemci IP'si başına token bucket. Her rota sınıfının kendi kovası var;
+// kova boşsa istek 429 + Retry-After ile hemen reddedilir, iş kuyruğa girmez.
+// Tablo sadece async_tcp task'ında kullanılır, kilit gerekmez.
+#define RATE_LIMIT_CLIENTS  16     // Takip edilen en fazla IP (dolunca en eski düşer)
+
+enum RateClass : uint8_t {
+    RATE_STATIC,        // Sayfalar, CSS/JS
+    RATE_API,           // JSON API
+    RATE_UART,          // UART'a iş kuyruklayan istekler
+    RATE_CLASS_COUNT
+};
+
+struct RateBudget {
+    uint16_t burst;         // Kova kapasitesi (istek)
+    uint16_t refillMs;      // Bir token'ın dolma süresi
+};
+
+// Token varsa harcar ve true döner; yoksa retryAfter'a bekleme süresini (s) yazar
+bool takeRateToken(uint32_t ip, RateClass rateClass, uint32_t& retryAfter);
+
+// Giriş kilidi de IP başınadır: başarısız denemeler sadece o IP'yi kilitler
+#define LOGIN_MAX_FAILURES   5
+#define LOGIN_LOCKOUT_MS     300000  // 5 dakika
+
+// Kilitliyse retryAfter'a kalan süreyi (s) yazar
+bool isLoginLocked(uint32_t ip, uint32_t& retryAfter);
+// Başarısız deneme sayısını döner; LOGIN_MAX_FAILURES'a ulaşınca IP kilitlenir
+uint8_t recordLoginFailure(uint32_t ip);
+void clearLoginFailures(uint32_t ip);
+
+#endif // RATE_LIMITER_H
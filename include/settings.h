@@ -2,7 +2,7 @@
 #define SETTINGS_H
 
 #include <Arduino.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ETH.h>
 
 struct Settings {
@@ -16,16 +16,19 @@ struct Settings {
     String passwordSalt;
     String passwordHash;
     long currentBaudRate;
-    bool isLoggedIn;
-    unsigned long sessionStartTime;
-    unsigned long SESSION_TIMEOUT;
+    unsigned long SESSION_TIMEOUT;      // Oturum hareketsizlik süresi (ms)
 };
 
-extern WebServer server;
+extern AsyncWebServer server;
 extern Settings settings;
 
 void loadSettings();
 bool saveSettings(const String& newDevName, const String& newTmName, const String& newUsername, const String& newPassword);
 void initEthernet();
 
+// Yapılandırma sürümü - ayar, NTP, baudrate veya yedekten geri yükleme
+// değişikliğinde artar. Config GET'lerinin ETag'i ve önbelleği buna bağlı.
+uint32_t getConfigVersion();
+void bumpConfigVersion();
+
 #endif
\ No newline at end of file
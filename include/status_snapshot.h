@@ -0,0 +1,45 @@
+#ifndef STATUS_SNAPSHOT_H
+#define STATUS_SNAPSHOT_H
+
+#include <Arduino.h>
+
+// Sistem durumu anlık görüntüsü - üretici task her tick'te bir kez JSON'a
+// ve MessagePack'e yazar; /api/status ve tüm WebSocket clientları aynı
+// tamponları gönderir.
+// İki tampon: biri okunurken diğeri doldurulur, yayın tek indeks değişimi.
+#define STATUS_SNAPSHOT_INTERVAL  1000   // Yenileme aralığı (ms)
+#define STATUS_SNAPSHOT_MAX       768    // Serileştirilmiş JSON (ve MessagePack) için en fazla byte
+#define STATUS_FIELD_MAX          16     // Durumdaki en fazla alan (aşılırsa görüntü yayınlanmaz)
+
+// Tek alanın JSON metni ("anahtar":değer) - json içindeki konumu ve CRC'si,
+// MessagePack karşılığının (anahtar + değer) packed içindeki konumu.
+// WebSocket delta gönderimi alanları bu CRC'lerle karşılaştırır.
+struct StatusField {
+    uint16_t offset;
+    uint16_t length;
+    uint16_t packedOffset;
+    uint16_t packedLength;
+    uint32_t hash;
+};
+
+struct StatusSnapshot {
+    char json[STATUS_SNAPSHOT_MAX];
+    size_t length;
+    uint8_t packed[STATUS_SNAPSHOT_MAX];    // Aynı görüntü MessagePack olarak
+    size_t packedLength;
+    uint32_t version;             // Her yayında artar
+    volatile uint8_t readers;     // Okunurken bu tampona yazılmaz
+    StatusField fields[STATUS_FIELD_MAX];   // type/version hariç alanlar
+    uint8_t fieldCount;
+};
+
+void initStatusSnapshot();
+// Sıradaki tick'i beklemeden yenile (ör. ayar değişince)
+void refreshStatusSnapshot();
+
+// Yayındaki görüntüyü okumak için al; işi bitince mutlaka bırak
+const StatusSnapshot* acquireStatusSnapshot();
+void releaseStatusSnapshot(const StatusSnapshot* snapshot);
+uint32_t getStatusSnapshotVersion();
+
+#endif // STATUS_SNAPSHOT_H
@@ -15,5 +15,6 @@ String getCurrentDate();
 String getCurrentTime();
 bool isTimeSynced();
 String getTimeSyncStats();
+void logTimeSyncStats();
 
 #endif // TIME_SYNC_H
\ No newline at end of file
@@ -0,0 +1,54 @@
+#ifndef UART_JOBS_H
+#define UART_JOBS_H
+
+#include <Arduino.h>
+
+// UART işleri - web/WebSocket tarafı UART'ı hiç beklemez; işi kuyruğa atar,
+// UART task'ı sırayla yürütür. Sonuç WebSocket "job" olayıyla yayınlanır ve
+// GET /api/jobs/{id} ile sorgulanabilir.
+#define UART_JOB_SLOTS       16      // Aynı anda bekleyebilecek iş sayısı
+#define UART_JOB_RESULT_TTL  30000   // Alınmayan sonuç bu süre sonra silinir (ms)
+#define UART_JOB_NOTIFIED_TTL 3000   // WebSocket'e yayınlanan sonuç poll için bu kadar daha tutulur (ms)
+
+enum UartJobType : uint8_t {
+    UART_JOB_FAULT_FIRST,
+    UART_JOB_FAULT_NEXT,
+    UART_JOB_SET_BAUDRATE,
+    UART_JOB_SEND_NTP,
+    UART_JOB_TEST
+};
+
+enum UartJobState : uint8_t {
+    UART_JOB_FREE,       // Bilinmeyen ya da süresi dolmuş id
+    UART_JOB_QUEUED,
+    UART_JOB_RUNNING,
+    UART_JOB_DONE
+};
+
+struct UartJobResult {
+    bool success;
+    String response;
+};
+
+struct UartJobInfo {
+    int32_t id;
+    UartJobType type;
+    UartJobState state;
+    UartJobResult result;   // Sadece UART_JOB_DONE iken geçerli
+};
+
+void initUartJobs();
+// Boş slot yoksa yayınlanmış en eski sonucun slotu kullanılır; hepsi
+// bekliyor/çalışıyorsa -1 döner
+int32_t submitUartJob(UartJobType type, long arg = 0);
+// İşin durumunu verir; bitmişse sonucu da kopyalar ve slotu boşaltır
+UartJobState pollUartJob(int32_t id, UartJobInfo& out);
+// Henüz yayınlanmamış biten bir işi verir (sonuç poll için saklanmaya devam eder)
+bool takeUartJobNotification(UartJobInfo& out);
+// UART task'ından çağrılır - en fazla wait kadar iş bekler, gelenleri yürütür
+void runUartJobs(TickType_t wait);
+
+const char* uartJobTypeToString(UartJobType type);
+const char* uartJobStateToString(UartJobState state);
+
+#endif // UART_JOBS_H
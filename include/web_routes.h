@@ -2,25 +2,35 @@
 #define WEB_ROUTES_H
 
 #include <Arduino.h>
+#include "rate_limiter.h"
+
+class AsyncWebServerRequest;
 
 void setupWebRoutes();
-void serveStaticFile(const String& path, const String& contentType);
 String getUptime();
-void addSecurityHeaders();
-bool checkRateLimit();
+void addSecurityHeaders(AsyncWebServerRequest* request);
+// Kova boşsa 429 + Retry-After gönderir ve false döner
+bool checkRateLimit(AsyncWebServerRequest* request, RateClass rateClass);
 
 // API Handler fonksiyonları
-void handleStatusAPI();
-void handleGetSettingsAPI();
-void handlePostSettingsAPI();
-void handleFaultRequest(bool isFirst);
-void handleGetNtpAPI();
-void handlePostNtpAPI();
-void handleGetBaudRateAPI();
-void handlePostBaudRateAPI();
-void handleGetLogsAPI();
-void handleClearLogsAPI();
-void handleSystemInfoAPI();
-void handleSessionRefresh();
+void handleStatusAPI(AsyncWebServerRequest* request);
+void handleGetSettingsAPI(AsyncWebServerRequest* request);
+void handlePostSettingsAPI(AsyncWebServerRequest* request);
+void handleFaultRequest(AsyncWebServerRequest* request, bool isFirst);
+void handleGetNtpAPI(AsyncWebServerRequest* request);
+void handlePostNtpAPI(AsyncWebServerRequest* request);
+void handleGetBaudRateAPI(AsyncWebServerRequest* request);
+void handlePostBaudRateAPI(AsyncWebServerRequest* request);
+void handleGetLogsAPI(AsyncWebServerRequest* request);
+void handleClearLogsAPI(AsyncWebServerRequest* request);
+void handleLogArchiveAPI(AsyncWebServerRequest* request);
+void handleGetLogLevelsAPI(AsyncWebServerRequest* request);
+void handlePostLogLevelsAPI(AsyncWebServerRequest* request);
+void handleSystemInfoAPI(AsyncWebServerRequest* request);
+void handleSessionRefresh(AsyncWebServerRequest* request);
+void handleGetJobAPI(AsyncWebServerRequest* request);
+void handleHttpMetricsAPI(AsyncWebServerRequest* request);
+void handleWebSocketMetricsAPI(AsyncWebServerRequest* request);
+void handleBatchAPI(AsyncWebServerRequest* request);
 
 #endif
\ No newline at end of file
@@ -4,9 +4,12 @@
 #include <Arduino.h>
 #include <WebSocketsServer.h>
 #include <ArduinoJson.h>
+#include "uart_jobs.h"
+#include "json_writer.h"
 
 // WebSocket port numarası
 #define WEBSOCKET_PORT 81
+#define WS_MAX_CLIENTS 5    // WebSocketsServer'ın ESP32 varsayılanı
 
 // WebSocket event türleri
 enum WSEventType {
@@ -23,10 +26,14 @@ void handleWebSocket();
 void broadcastLog(const String& message, const String& level, const String& source);
 void broadcastStatus();
 void broadcastFault(const String& faultData);
+void broadcastJobResult(const UartJobInfo& job);
 void sendToClient(uint8_t clientNum, const String& message);
 void sendToAllClients(const String& message);
 bool isWebSocketConnected();
 int getWebSocketClientCount();
+// Client başına gönderim kuyruğu istatistikleri (/api/metrics/ws) -
+// JsonStepWriter: her çağrıda bir client
+bool writeWebSocketMetricsJson(JsonWriter& json, uint16_t index);
 
 // WebSocket event callback
 void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length);
@@ -0,0 +1,292 @@
+# Web varlıkları için derleme öncesi adım (PlatformIO extra_scripts = pre:)
+#
+# data/ altındaki dosyaları küçültür ve gzip'ler, CSS/JS dosyalarına içerik
+# hash'li adlar verir (style.<hash>.css), HTML içindeki referansları bu
+# adlarla değiştirir. Sonuç .pio/web/web_assets.h içine flash'ta duran
+# constexpr diziler ve mükemmel hash'li bir arama tablosu olarak yazılır
+# (hash'li adların makroları ayrıca küçük .pio/web/web_asset_names.h içinde);
+# firmware statik dosyalar için LittleFS'e hiç dokunmaz. uploadfs boş .pio/web/data dizinini
+# kullanır (LittleFS sadece log ve yedekler için).
+#
+# PlatformIO dışında da çalışır: python scripts/build_web_assets.py
+
+import gzip
+import hashlib
+import io
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 - PlatformIO tarafından sağlanır
+    PROJECT_DIR = env.subst("$PROJECT_DIR")  # noqa: F821
+except NameError:
+    env = None
+    PROJECT_DIR = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+SOURCE_DIR = os.path.join(PROJECT_DIR, "data")
+WEB_DIR = os.path.join(PROJECT_DIR, ".pio", "web")
+OUTPUT_DIR = os.path.join(WEB_DIR, "data")
+HEADER_PATH = os.path.join(WEB_DIR, "web_assets.h")
+# Sadece hash'li ad makroları - sayfa üreten diğer kaynaklar veri dizilerini çekmesin
+NAMES_HEADER_PATH = os.path.join(WEB_DIR, "web_asset_names.h")
+
+# İçerik hash'i ile adlandırılan (immutable önbelleklenen) dosyalar
+HASHED_EXTENSIONS = (".css", ".js")
+HASH_LENGTH = 8
+
+# Sayfa adresleri: index.html -> "/", x.html -> "/x"
+INDEX_PAGE = "index.html"
+# Oturum açıkken yönlendirilen sayfalar; diğer HTML sayfaları oturum ister
+GUEST_PAGES = ("login.html",)
+
+CONTENT_TYPES = {
+    ".html": "text/html",
+    ".css": "text/css",
+    ".js": "application/javascript",
+    ".json": "application/json",
+    ".svg": "image/svg+xml",
+    ".ico": "image/x-icon",
+}
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    # Seçicilerde anlam taşıyan boşluklara (ör. "a :hover") dokunma
+    text = re.sub(r"\s*([{};,])\s*", r"\1", text)
+    text = re.sub(r":\s+", ":", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    # Güvenli küçültme: satır yapısı korunur (ASI bozulmaz), sadece girinti,
+    # boş satırlar ve tam satır yorumlar atılır
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if not line or line.startswith("//"):
+            continue
+        lines.append(line)
+    return "\n".join(lines)
+
+
+def minify_html(text):
+    text = re.sub(r"<!--.*?-->", "", text, flags=re.S)
+    return minify_js(text)
+
+
+MINIFIERS = {
+    ".css": minify_css,
+    ".js": minify_js,
+    ".html": minify_html,
+}
+
+
+def gzip_bytes(data):
+    # mtime=0: aynı girdi her zaman aynı çıktıyı verir (gereksiz yükleme olmaz)
+    buffer = io.BytesIO()
+    with gzip.GzipFile(fileobj=buffer, mode="wb", compresslevel=9, mtime=0) as f:
+        f.write(data)
+    return buffer.getvalue()
+
+
+def write_if_changed(path, data):
+    if os.path.exists(path):
+        with open(path, "rb") as f:
+            if f.read() == data:
+                return
+    with open(path, "wb") as f:
+        f.write(data)
+
+
+def header_macro(name):
+    return "WEB_ASSET_" + re.sub(r"[^A-Za-z0-9]", "_", name).upper()
+
+
+def c_array(data):
+    rows = []
+    for i in range(0, len(data), 16):
+        rows.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    return "\n".join(rows)
+
+
+def asset_url(name, renamed):
+    if name == INDEX_PAGE:
+        return "/"
+    if name.endswith(".html"):
+        return "/" + name[:-len(".html")]
+    return "/" + renamed.get(name, name)
+
+
+def asset_auth(name):
+    if not name.endswith(".html"):
+        return "WEB_AUTH_PUBLIC"
+    return "WEB_AUTH_GUEST" if name in GUEST_PAGES else "WEB_AUTH_SESSION"
+
+
+def fnv1a(text, seed):
+    # Firmware'deki webAssetHash() ile birebir aynı olmalı
+    h = (2166136261 ^ seed) & 0xFFFFFFFF
+    for b in text.encode("utf-8"):
+        h ^= b
+        h = (h * 16777619) & 0xFFFFFFFF
+    return h
+
+
+def perfect_hash(urls):
+    # Çakışmasız (seed, tablo boyu) çiftini ara; en küçük tablo tercih edilir
+    for size in range(len(urls), 4 * len(urls) + 1):
+        for seed in range(1 << 16):
+            slots = [-1] * size
+            for index, url in enumerate(urls):
+                slot = fnv1a(url, seed) % size
+                if slots[slot] >= 0:
+                    break
+                slots[slot] = index
+            else:
+                return seed, slots
+    raise RuntimeError("Mükemmel hash bulunamadı")
+
+
+def build():
+    os.makedirs(OUTPUT_DIR, exist_ok=True)
+
+    sources = {}
+    for name in sorted(os.listdir(SOURCE_DIR)):
+        path = os.path.join(SOURCE_DIR, name)
+        if not os.path.isfile(path):
+            continue
+        with open(path, "r", encoding="utf-8") as f:
+            text = f.read().replace("\r\n", "\n")
+        ext = os.path.splitext(name)[1]
+        sources[name] = MINIFIERS.get(ext, lambda t: t)(text)
+
+    # Önce hash'li adlar, sonra HTML referansları
+    renamed = {}
+    for name, text in sources.items():
+        base, ext = os.path.splitext(name)
+        if ext in HASHED_EXTENSIONS:
+            digest = hashlib.sha256(text.encode("utf-8")).hexdigest()[:HASH_LENGTH]
+            renamed[name] = "%s.%s%s" % (base, digest, ext)
+
+    assets = []
+    total_in = total_out = 0
+    for name, text in sources.items():
+        if name.endswith(".html"):
+            for old, new in renamed.items():
+                text = re.sub(r'(href|src)="/?%s"' % re.escape(old), r'\1="/%s"' % new, text)
+        raw = text.encode("utf-8")
+        data = gzip_bytes(raw)
+        compressed = len(data) < len(raw)
+        if not compressed:
+            data = raw
+        assets.append({
+            "url": asset_url(name, renamed),
+            "type": CONTENT_TYPES.get(os.path.splitext(name)[1], "application/octet-stream"),
+            "etag": '\\"%s\\"' % hashlib.sha256(raw).hexdigest()[:16],
+            "data": data,
+            "auth": asset_auth(name),
+            "gzip": compressed,
+            "immutable": name in renamed,
+        })
+        total_in += os.path.getsize(os.path.join(SOURCE_DIR, name))
+        total_out += len(data)
+
+    seed, slots = perfect_hash([asset["url"] for asset in assets])
+
+    # LittleFS imajına artık web dosyası girmez
+    for name in os.listdir(OUTPUT_DIR):
+        os.remove(os.path.join(OUTPUT_DIR, name))
+
+    def flag(value):
+        return "true" if value else "false"
+
+    names = [
+        "// Otomatik üretildi: scripts/build_web_assets.py - elle düzenlemeyin",
+        "#ifndef WEB_ASSET_NAMES_H",
+        "#define WEB_ASSET_NAMES_H",
+        "",
+    ]
+    for name in sorted(renamed):
+        names.append('#define %-24s "/%s"' % (header_macro(name), renamed[name]))
+    names += [
+        "",
+        "#endif // WEB_ASSET_NAMES_H",
+        "",
+    ]
+    write_if_changed(NAMES_HEADER_PATH, "\n".join(names).encode("utf-8"))
+
+    lines = [
+        "// Otomatik üretildi: scripts/build_web_assets.py - elle düzenlemeyin",
+        "#ifndef WEB_ASSETS_H",
+        "#define WEB_ASSETS_H",
+        "",
+        "#include <Arduino.h>",
+        "#include \"web_asset_names.h\"",
+        "",
+        "enum WebAssetAuth : uint8_t {",
+        "    WEB_AUTH_PUBLIC,         // Herkese açık (CSS/JS)",
+        "    WEB_AUTH_SESSION,        // Oturum yoksa /login'e yönlendir",
+        "    WEB_AUTH_GUEST           // Oturum varsa /'a yönlendir",
+        "};",
+        "",
+        "struct WebAsset {",
+        "    const char* path;",
+        "    const char* contentType;",
+        "    const char* etag;",
+        "    const uint8_t* data;     // Flash (rodata)",
+        "    uint32_t length;",
+        "    WebAssetAuth auth;",
+        "    bool gzip;               // data gzip'li mi",
+        "    bool immutable;          // İçerik hash'li ad - süresiz önbellek",
+        "};",
+        "",
+    ]
+    for index, asset in enumerate(assets):
+        lines.append("// %s (%d byte)" % (asset["url"], len(asset["data"])))
+        lines.append("static constexpr uint8_t WEB_ASSET_DATA_%d[] = {" % index)
+        lines.append(c_array(asset["data"]))
+        lines.append("};")
+        lines.append("")
+    lines.append("static constexpr WebAsset WEB_ASSETS[] = {")
+    for index, asset in enumerate(assets):
+        lines.append('    {"%s", "%s", "%s", WEB_ASSET_DATA_%d, %d, %s, %s, %s},' % (
+            asset["url"], asset["type"], asset["etag"], index, len(asset["data"]),
+            asset["auth"], flag(asset["gzip"]), flag(asset["immutable"])))
+    lines += [
+        "};",
+        "",
+        "#define WEB_ASSET_COUNT (sizeof(WEB_ASSETS) / sizeof(WEB_ASSETS[0]))",
+        "",
+        "// Yollar üzerinde mükemmel hash: her yol tek bir slota düşer",
+        "#define WEB_ASSET_HASH_SEED  %uU" % seed,
+        "#define WEB_ASSET_HASH_SIZE  %d" % len(slots),
+        "",
+        "static constexpr int8_t WEB_ASSET_SLOTS[WEB_ASSET_HASH_SIZE] = {",
+        "    " + ", ".join(str(slot) for slot in slots),
+        "};",
+        "",
+        "// FNV-1a - scripts/build_web_assets.py içindeki fnv1a() ile aynı",
+        "static inline uint32_t webAssetHash(const char* path) {",
+        "    uint32_t h = 2166136261U ^ WEB_ASSET_HASH_SEED;",
+        "    while (*path) {",
+        "        h ^= (uint8_t)*path++;",
+        "        h *= 16777619U;",
+        "    }",
+        "    return h;",
+        "}",
+        "",
+        "#endif // WEB_ASSETS_H",
+        "",
+    ]
+    write_if_changed(HEADER_PATH, "\n".join(lines).encode("utf-8"))
+
+    print("Web varlıkları: %d dosya, %d -> %d byte, hash tablosu %d slot (seed %d)" % (
+        len(assets), total_in, total_out, len(slots), seed))
+
+
+build()
+
+if env is not None:
+    env.Replace(PROJECT_DATA_DIR=OUTPUT_DIR)
+    env.Append(CPPPATH=[WEB_DIR])
@@ -2,96 +2,374 @@
 #include "settings.h"
 #include "log_system.h"
 #include "crypto_utils.h"
-#include <WebServer.h>
+#include "chunked_response.h"
+#include "rate_limiter.h"
+#include <ESPAsyncWebServer.h>
 
 extern Settings settings;
-extern WebServer server;
 
-// Giriş denemesi sayacı ve kilitlenme sistemi
-static int loginAttempts = 0;
-static unsigned long lockoutTime = 0;
-const int MAX_LOGIN_ATTEMPTS = 5;
-const unsigned long LOCKOUT_DURATION = 300000; // 5 dakika
+struct Session {
+    uint8_t token[SESSION_TOKEN_BYTES];
+    unsigned long lastSeen;     // Hareketsizlik süresi settings.SESSION_TIMEOUT
+    bool used;
+};
 
-bool checkSession() {
-    if (!settings.isLoggedIn) return false;
-    if (millis() - settings.sessionStartTime > settings.SESSION_TIMEOUT) {
-        settings.isLoggedIn = false;
-        addLog("Oturum zaman aşımı", INFO, "AUTH");
-        return false;
+static Session sessions[SESSION_SLOTS];
+static int sessionCount = 0;
+static portMUX_TYPE sessionMux = portMUX_INITIALIZER_UNLOCKED;   // HTTP (async_tcp) + loop
+static volatile uint32_t sessionGeneration = 0;
+
+struct WsTicket {
+    uint8_t ticket[SESSION_TOKEN_BYTES];
+    uint8_t token[SESSION_TOKEN_BYTES];
+    unsigned long issued;
+    bool used;
+};
+
+static WsTicket wsTickets[WS_TICKET_SLOTS];   // sessionMux altında
+
+#define SESSION_MASK (SESSION_SLOTS - 1)
+
+static uint8_t homeSlot(const uint8_t* token) {
+    uint32_t h;
+    memcpy(&h, token, sizeof(h));
+    return h & SESSION_MASK;
+}
+
+// Sabit zamanlı karşılaştırma - eşleşen bayt sayısı süreden okunamaz
+static bool tokenEquals(const uint8_t* a, const uint8_t* b) {
+    uint8_t diff = 0;
+    for (int i = 0; i < SESSION_TOKEN_BYTES; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+static bool parseToken(const char* hex, size_t length, uint8_t* token) {
+    if (length != SESSION_TOKEN_BYTES * 2) return false;
+    for (int i = 0; i < SESSION_TOKEN_BYTES; i++) {
+        uint8_t value = 0;
+        for (int j = 0; j < 2; j++) {
+            char c = hex[i * 2 + j];
+            value <<= 4;
+            if (c >= '0' && c <= '9') value |= c - '0';
+            else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+            else return false;
+        }
+        token[i] = value;
     }
     return true;
 }
 
-void handleUserLogin() {
-    // Rate limiting kontrolü
-    if (lockoutTime > 0 && millis() < lockoutTime) {
-        unsigned long remainingTime = (lockoutTime - millis()) / 1000;
-        addLog("Çok fazla başarısız giriş denemesi. Kalan süre: " + String(remainingTime) + "s", WARN, "AUTH");
-        server.send(429, "application/json", 
-            "{\"error\":\"Çok fazla başarısız deneme. " + String(remainingTime) + " saniye sonra tekrar deneyin.\"}");
+static String formatToken(const uint8_t* token) {
+    char hex[SESSION_TOKEN_BYTES * 2 + 1];
+    for (int i = 0; i < SESSION_TOKEN_BYTES; i++) {
+        sprintf(hex + i * 2, "%02x", token[i]);
+    }
+    return String(hex);
+}
+
+// "a=1; SID=...; b=2" içinden oturum token'ı
+static bool tokenFromCookie(const String& cookie, uint8_t* token) {
+    int start = 0;
+    while (start < (int)cookie.length()) {
+        while (cookie.charAt(start) == ' ') start++;
+        int end = cookie.indexOf(';', start);
+        if (end < 0) end = cookie.length();
+        size_t nameLength = strlen(SESSION_COOKIE "=");
+        if (strncmp(cookie.c_str() + start, SESSION_COOKIE "=", nameLength) == 0) {
+            int value = start + nameLength;
+            return parseToken(cookie.c_str() + value, end - value, token);
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+// Kilit altında çağrılır. Bulunamazsa -1.
+static int findSessionLocked(const uint8_t* token) {
+    uint8_t slot = homeSlot(token);
+    for (int i = 0; i < SESSION_SLOTS; i++) {
+        if (!sessions[slot].used) return -1;
+        if (tokenEquals(sessions[slot].token, token)) return slot;
+        slot = (slot + 1) & SESSION_MASK;
+    }
+    return -1;
+}
+
+// Kilit altında çağrılır. Doğrusal yoklamada mezar taşı yerine geri kaydırma:
+// boşluktan sonraki zincir, ev slotlarını geçmeyecek şekilde geri çekilir.
+static void removeSessionLocked(uint8_t slot) {
+    sessions[slot].used = false;
+    sessionCount--;
+    sessionGeneration++;
+    
+    uint8_t hole = slot;
+    uint8_t next = (slot + 1) & SESSION_MASK;
+    while (sessions[next].used) {
+        uint8_t home = homeSlot(sessions[next].token);
+        if (((next - home) & SESSION_MASK) >= ((next - hole) & SESSION_MASK)) {
+            sessions[hole] = sessions[next];
+            sessions[next].used = false;
+            hole = next;
+        }
+        next = (next + 1) & SESSION_MASK;
+    }
+}
+
+static bool isExpired(const Session& session, unsigned long now) {
+    return now - session.lastSeen > settings.SESSION_TIMEOUT;
+}
+
+// Yeni oturum aç; tablo doluysa en uzun süredir kullanılmayanı düşür
+static void createSession(uint8_t* token) {
+    fillSecureRandom(token, SESSION_TOKEN_BYTES);
+    unsigned long now = millis();
+    
+    portENTER_CRITICAL(&sessionMux);
+    if (sessionCount >= SESSION_MAX) {
+        int oldest = -1;
+        for (int i = 0; i < SESSION_SLOTS; i++) {
+            if (sessions[i].used &&
+                (oldest < 0 || now - sessions[i].lastSeen > now - sessions[oldest].lastSeen)) {
+                oldest = i;
+            }
+        }
+        removeSessionLocked(oldest);
+    }
+    
+    uint8_t slot = homeSlot(token);
+    while (sessions[slot].used) {
+        slot = (slot + 1) & SESSION_MASK;
+    }
+    memcpy(sessions[slot].token, token, SESSION_TOKEN_BYTES);
+    sessions[slot].lastSeen = now;
+    sessions[slot].used = true;
+    sessionCount++;
+    portEXIT_CRITICAL(&sessionMux);
+}
+
+// Token geçerliyse süresini uzatır; süresi dolmuşsa siler
+static bool validateToken(const uint8_t* token) {
+    unsigned long now = millis();
+    bool valid = false;
+    bool expired = false;
+    
+    portENTER_CRITICAL(&sessionMux);
+    int slot = findSessionLocked(token);
+    if (slot >= 0) {
+        if (isExpired(sessions[slot], now)) {
+            removeSessionLocked(slot);
+            expired = true;
+        } else {
+            sessions[slot].lastSeen = now;
+            valid = true;
+        }
+    }
+    portEXIT_CRITICAL(&sessionMux);
+    
+    if (expired) LOGI(LOG_SRC_AUTH, LT_AUTH_SESSION_TIMEOUT);
+    return valid;
+}
+
+bool checkSession(AsyncWebServerRequest* request) {
+    if (!request->hasHeader("Cookie")) return false;
+    
+    uint8_t token[SESSION_TOKEN_BYTES];
+    if (!tokenFromCookie(request->header("Cookie"), token)) return false;
+    return validateToken(token);
+}
+
+bool checkSessionCookie(const String& cookieHeader) {
+    uint8_t token[SESSION_TOKEN_BYTES];
+    if (!tokenFromCookie(cookieHeader, token)) return false;
+    return validateToken(token);
+}
+
+void expireSessions() {
+    unsigned long now = millis();
+    int expired = 0;
+    
+    portENTER_CRITICAL(&sessionMux);
+    for (int i = 0; i < SESSION_SLOTS; i++) {
+        // Geri kaydırma bu slota başka bir oturum taşıyabilir - tekrar bak
+        while (sessions[i].used && isExpired(sessions[i], now)) {
+            removeSessionLocked(i);
+            expired++;
+        }
+    }
+    portEXIT_CRITICAL(&sessionMux);
+    
+    for (int i = 0; i < expired; i++) {
+        LOGI(LOG_SRC_AUTH, LT_AUTH_SESSION_TIMEOUT);
+    }
+}
+
+void endAllSessions() {
+    portENTER_CRITICAL(&sessionMux);
+    for (int i = 0; i < SESSION_SLOTS; i++) {
+        sessions[i].used = false;
+    }
+    for (int i = 0; i < WS_TICKET_SLOTS; i++) {
+        wsTickets[i].used = false;
+    }
+    sessionCount = 0;
+    sessionGeneration++;
+    portEXIT_CRITICAL(&sessionMux);
+}
+
+int getActiveSessionCount() {
+    return sessionCount;
+}
+
+bool isSessionActive(const uint8_t* token) {
+    unsigned long now = millis();
+    portENTER_CRITICAL(&sessionMux);
+    int slot = findSessionLocked(token);
+    bool active = slot >= 0 && !isExpired(sessions[slot], now);
+    portEXIT_CRITICAL(&sessionMux);
+    return active;
+}
+
+uint32_t getSessionGeneration() {
+    return sessionGeneration;
+}
+
+// Boş ya da en eski bilet slotu yeniden kullanılır
+void handleWsTicket(AsyncWebServerRequest* request) {
+    uint8_t token[SESSION_TOKEN_BYTES];
+    if (!request->hasHeader("Cookie") || !tokenFromCookie(request->header("Cookie"), token) ||
+        !validateToken(token)) {
+        sendJsonError(request, 401, "Oturum geçersiz");
         return;
     }
+    
+    uint8_t ticket[SESSION_TOKEN_BYTES];
+    fillSecureRandom(ticket, SESSION_TOKEN_BYTES);
+    unsigned long now = millis();
+    
+    portENTER_CRITICAL(&sessionMux);
+    int slot = 0;
+    for (int i = 0; i < WS_TICKET_SLOTS; i++) {
+        if (!wsTickets[i].used || now - wsTickets[i].issued > WS_TICKET_TTL) {
+            slot = i;
+            break;
+        }
+        if (now - wsTickets[i].issued > now - wsTickets[slot].issued) slot = i;
+    }
+    memcpy(wsTickets[slot].ticket, ticket, SESSION_TOKEN_BYTES);
+    memcpy(wsTickets[slot].token, token, SESSION_TOKEN_BYTES);
+    wsTickets[slot].issued = now;
+    wsTickets[slot].used = true;
+    portEXIT_CRITICAL(&sessionMux);
+    
+    JsonResponse* body = new JsonResponse();
+    body->json.beginObject();
+    body->json.field("ticket", formatToken(ticket));
+    body->json.endObject();
+    sendJson(request, body);
+}
 
-    String u = server.arg("username");
-    String p = server.arg("password");
+bool redeemWsTicket(const char* hex, size_t length, uint8_t* token) {
+    uint8_t ticket[SESSION_TOKEN_BYTES];
+    if (!parseToken(hex, length, ticket)) return false;
+    
+    unsigned long now = millis();
+    bool found = false;
+    portENTER_CRITICAL(&sessionMux);
+    for (int i = 0; i < WS_TICKET_SLOTS; i++) {
+        if (wsTickets[i].used && tokenEquals(wsTickets[i].ticket, ticket)) {
+            wsTickets[i].used = false;
+            found = now - wsTickets[i].issued <= WS_TICKET_TTL;
+            if (found) memcpy(token, wsTickets[i].token, SESSION_TOKEN_BYTES);
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&sessionMux);
+    return found;
+}
+
+static void sendLockoutError(AsyncWebServerRequest* request, unsigned long seconds) {
+    char message[96];
+    snprintf(message, sizeof(message),
+             "Çok fazla başarısız deneme. %lu saniye sonra tekrar deneyin.", seconds);
+    sendJsonError(request, 429, message);
+}
+
+void handleUserLogin(AsyncWebServerRequest* request) {
+    // Kilitlenme istemci IP'si başına - bir IP'nin denemeleri diğerlerini kilitlemez
+    uint32_t ip = (uint32_t)request->client()->remoteIP();
+    uint32_t remainingTime = 0;
+    if (isLoginLocked(ip, remainingTime)) {
+        LOGW(LOG_SRC_AUTH, LT_AUTH_LOCKED_OUT, (unsigned long)remainingTime);
+        sendLockoutError(request, remainingTime);
+        return;
+    }
+
+    String u = request->arg("username");
+    String p = request->arg("password");
 
     // Input validation
     if (u.length() == 0 || p.length() == 0) {
-        server.send(400, "application/json", "{\"error\":\"Kullanıcı adı ve şifre boş olamaz.\"}");
+        sendJsonError(request, 400, "Kullanıcı adı ve şifre boş olamaz.");
         return;
     }
 
     // Kullanıcı adı ve şifre uzunluk kontrolü
     if (u.length() > 50 || p.length() > 100) {
-        addLog("Aşırı uzun giriş denemesi", WARN, "AUTH");
-        server.send(400, "application/json", "{\"error\":\"Geçersiz giriş bilgileri.\"}");
+        LOGW(LOG_SRC_AUTH, LT_AUTH_INPUT_TOO_LONG);
+        sendJsonError(request, 400, "Geçersiz giriş bilgileri.");
         return;
     }
 
     if (u == settings.username) {
         String hashedAttempt = sha256(p, settings.passwordSalt);
         if (hashedAttempt == settings.passwordHash) {
-            settings.isLoggedIn = true;
-            settings.sessionStartTime = millis();
-            loginAttempts = 0;
-            lockoutTime = 0;
+            uint8_t token[SESSION_TOKEN_BYTES];
+            createSession(token);
+            clearLoginFailures(ip);
             
-            addLog("✅ Başarılı giriş: " + u, SUCCESS, "AUTH");
-            server.sendHeader("Location", "/", true);
-            server.send(302, "text/plain", "Redirecting to dashboard..."); // İçerik eklendi
+            LOGS(LOG_SRC_AUTH, LT_AUTH_LOGIN_OK, u);
+            AsyncWebServerResponse* response = request->beginResponse(302);
+            response->addHeader("Location", "/");
+            response->addHeader("Set-Cookie", String(SESSION_COOKIE "=") + formatToken(token) +
+                                "; Path=/; HttpOnly; SameSite=Strict");
+            request->send(response);
             return;
         }
     }
 
     // Başarısız giriş işlemi
-    loginAttempts++;
-    addLog("❌ Başarısız giriş denemesi (#" + String(loginAttempts) + "): " + u, ERROR, "AUTH");
-
-    // Maksimum deneme sayısına ulaşıldı mı?
-    if (loginAttempts >= MAX_LOGIN_ATTEMPTS) {
-        lockoutTime = millis() + LOCKOUT_DURATION;
-        addLog("🔒 IP adresi " + String(LOCKOUT_DURATION/1000) + " saniye kilitlendi", WARN, "AUTH");
-        server.send(429, "application/json", 
-            "{\"error\":\"Çok fazla başarısız deneme. " + String(LOCKOUT_DURATION/1000) + " saniye sonra tekrar deneyin.\"}");
+    uint8_t attempts = recordLoginFailure(ip);
+    LOGE(LOG_SRC_AUTH, LT_AUTH_LOGIN_FAILED, (int)attempts, u);
+
+    // Maksimum deneme sayısına ulaşıldı mı? (sadece bu IP kilitlenir)
+    if (attempts >= LOGIN_MAX_FAILURES) {
+        LOGW(LOG_SRC_AUTH, LT_AUTH_LOCKOUT, LOGIN_LOCKOUT_MS/1000);
+        sendLockoutError(request, LOGIN_LOCKOUT_MS/1000);
         return;
     }
 
-    server.send(401, "application/json", "{\"error\":\"Kullanıcı adı veya şifre hatalı!\"}");
+    sendJsonError(request, 401, "Kullanıcı adı veya şifre hatalı!");
 }
 
-void handleUserLogout() {
-    if (settings.isLoggedIn) {
-        settings.isLoggedIn = false;
-        addLog("🚪 Çıkış yapıldı", INFO, "AUTH");
-    }
-    server.sendHeader("Location", "/login", true);
-    server.send(302, "text/plain", "Redirecting to login..."); // İçerik eklendi
-}
-
-// Session yenileme fonksiyonu
-void refreshSession() {
-    if (settings.isLoggedIn) {
-        settings.sessionStartTime = millis();
+// Sadece bu isteğin oturumu kapanır, diğer kullanıcılar etkilenmez
+void handleUserLogout(AsyncWebServerRequest* request) {
+    uint8_t token[SESSION_TOKEN_BYTES];
+    if (request->hasHeader("Cookie") && tokenFromCookie(request->header("Cookie"), token)) {
+        bool removed = false;
+        portENTER_CRITICAL(&sessionMux);
+        int slot = findSessionLocked(token);
+        if (slot >= 0) {
+            removeSessionLocked(slot);
+            removed = true;
+        }
+        portEXIT_CRITICAL(&sessionMux);
+        if (removed) LOGI(LOG_SRC_AUTH, LT_AUTH_LOGOUT);
     }
+    
+    AsyncWebServerResponse* response = request->beginResponse(302);
+    response->addHeader("Location", "/login");
+    response->addHeader("Set-Cookie", SESSION_COOKIE "=; Path=/; Max-Age=0; HttpOnly; SameSite=Strict");
+    request->send(response);
 }
\ No newline at end of file
@@ -1,188 +1,351 @@
 #include "backup_restore.h"
-#include <ArduinoJson.h>
 #include <LittleFS.h>
 #include <Preferences.h>
 #include "settings.h"
 #include "log_system.h"
+#include "log_storage.h"
 #include "ntp_handler.h"
 #include "crypto_utils.h"
 #include "auth_system.h"  // checkSession için
-#include <WebServer.h>
+#include "chunked_response.h"
+#include "json_writer.h"
+#include "json_reader.h"
+#include <StreamString.h>
+#include <ESPAsyncWebServer.h>
 
-extern WebServer server;
+#define BACKUP_MAX_UPLOAD    16384   // Yedek dosyası için üst sınır (byte)
+#define BACKUP_MAX_VALUE     64      // Geri yüklenen tek bir alanın üst sınırı
+#define BACKUP_READ_CHUNK    256     // Dosyadan okuma parçası
+#define RESTART_DELAY        2000    // Yanıt gittikten sonra restart gecikmesi (ms)
+
+// Yükleme durumu isteğin _tempObject'inde tutulur; sunucu istekle birlikte
+// serbest bırakır, yarıda kopan yüklemeden geriye işaretçi kalmaz. Okuyucu
+// tektir, id'si uploadId'ye eşit olan yükleme onun sahibidir.
+struct BackupUpload {
+    uint32_t id;
+    size_t received;
+    bool overflow;
+};
+
+static uint32_t uploadId = 0;
+static unsigned long restartAt = 0;
+
+// Ayarları JSON olarak yaz - indirme yanıtına ve yedek dosyasına aynı yazıcı.
+// JsonStepWriter: her çağrıda bir bölüm
+static bool writeSettingsBackup(JsonWriter& json, uint16_t index) {
+    switch (index) {
+        case 0:
+            json.beginObject();
+            
+            // Versiyon bilgisi
+            json.field("version", "1.0");
+            json.field("timestamp", getFormattedTimestamp());
+            json.field("deviceId", ETH.macAddress());
+            return true;
+            
+        case 1:
+            // Network ayarları
+            json.key("network");
+            json.beginObject();
+            json.field("localIP", settings.local_IP.toString());
+            json.field("gateway", settings.gateway.toString());
+            json.field("subnet", settings.subnet.toString());
+            json.field("dns", settings.primaryDNS.toString());
+            json.endObject();
+            return true;
+            
+        case 2:
+            // Cihaz bilgileri
+            json.key("device");
+            json.beginObject();
+            json.field("name", settings.deviceName);
+            json.field("tmName", settings.transformerStation);
+            json.field("baudRate", settings.currentBaudRate);
+            json.endObject();
+            return true;
+            
+        case 3:
+            // Kullanıcı ayarları (şifre hariç)
+            json.key("user");
+            json.beginObject();
+            json.field("username", settings.username);
+            json.field("sessionTimeout", settings.SESSION_TIMEOUT);
+            json.endObject();
+            return true;
+            
+        case 4:
+            // NTP ayarları
+            json.key("ntp");
+            json.beginObject();
+            json.field("server1", (const char*)ntpConfig.ntpServer1);
+            json.field("server2", (const char*)ntpConfig.ntpServer2);
+            json.field("timezone", ntpConfig.timezone);
+            json.field("enabled", ntpConfig.enabled);
+            json.endObject();
+            return true;
+            
+        case 5:
+            // Log ayarları
+            json.key("logging");
+            json.beginObject();
+            json.field("maxLogs", (unsigned long)getLogCapacity());
+            json.field("currentLogs", (unsigned long)totalLogs);
+            json.endObject();
+            return true;
+            
+        default:
+            // Sistem bilgileri
+            json.key("system");
+            json.beginObject();
+            json.field("freeHeap", (unsigned long)ESP.getFreeHeap());
+            json.field("chipRevision", (unsigned long)ESP.getChipRevision());
+            json.field("sdkVersion", ESP.getSdkVersion());
+            json.field("flashSize", (unsigned long)ESP.getFlashChipSize());
+            json.endObject();
+            
+            json.endObject();
+            
+            LOGS(LOG_SRC_BACKUP, LT_BACKUP_EXPORTED);
+            return false;
+    }
+}
 
 // Ayarları JSON formatında export et
 String exportSettingsToJSON() {
-    // JSON document oluştur (2KB buffer) - Yeni ArduinoJson v7 syntax
-    JsonDocument doc;
-    
-    // Versiyon bilgisi
-    doc["version"] = "1.0";
-    doc["timestamp"] = getFormattedTimestamp();
-    doc["deviceId"] = ETH.macAddress();
-    
-    // Network ayarları
-    JsonObject network = doc["network"].to<JsonObject>();
-    network["localIP"] = settings.local_IP.toString();
-    network["gateway"] = settings.gateway.toString();
-    network["subnet"] = settings.subnet.toString();
-    network["dns"] = settings.primaryDNS.toString();
-    
-    // Cihaz bilgileri
-    JsonObject device = doc["device"].to<JsonObject>();
-    device["name"] = settings.deviceName;
-    device["tmName"] = settings.transformerStation;
-    device["baudRate"] = settings.currentBaudRate;
-    
-    // Kullanıcı ayarları (şifre hariç)
-    JsonObject user = doc["user"].to<JsonObject>();
-    user["username"] = settings.username;
-    user["sessionTimeout"] = settings.SESSION_TIMEOUT;
-    
-    // NTP ayarları
-    JsonObject ntp = doc["ntp"].to<JsonObject>();
-    ntp["server1"] = String(ntpConfig.ntpServer1);
-    ntp["server2"] = String(ntpConfig.ntpServer2);
-    ntp["timezone"] = ntpConfig.timezone;
-    ntp["enabled"] = ntpConfig.enabled;
+    StreamString output;
+    JsonWriter json(output);
+    writeJsonSteps(json, writeSettingsBackup);
+    return output;
+}
+
+// Yedekten geri yüklenen alanlar - diğer her şey (system, logging...) sadece
+// sözdizimi için okunur ve atlanır
+enum BackupFieldId : uint8_t {
+    BF_VERSION,
+    BF_LOCAL_IP,
+    BF_GATEWAY,
+    BF_SUBNET,
+    BF_DNS,
+    BF_DEV_NAME,
+    BF_TM_NAME,
+    BF_BAUD_RATE,
+    BF_USERNAME,
+    BF_SESSION_TIMEOUT,
+    BF_NTP_SERVER1,
+    BF_NTP_SERVER2,
+    BF_TIMEZONE,
+    BF_NTP_ENABLED,
+    BF_COUNT
+};
+
+struct BackupField {
+    const char* section;   // NULL: kök seviye
+    const char* key;
+    JsonReaderType type;
+};
+
+static const BackupField BACKUP_FIELDS[BF_COUNT] = {
+    {NULL,      "version",        JSON_READER_STRING},
+    {"network", "localIP",        JSON_READER_STRING},
+    {"network", "gateway",        JSON_READER_STRING},
+    {"network", "subnet",         JSON_READER_STRING},
+    {"network", "dns",            JSON_READER_STRING},
+    {"device",  "name",           JSON_READER_STRING},
+    {"device",  "tmName",         JSON_READER_STRING},
+    {"device",  "baudRate",       JSON_READER_NUMBER},
+    {"user",    "username",       JSON_READER_STRING},
+    {"user",    "sessionTimeout", JSON_READER_NUMBER},
+    {"ntp",     "server1",        JSON_READER_STRING},
+    {"ntp",     "server2",        JSON_READER_STRING},
+    {"ntp",     "timezone",       JSON_READER_NUMBER},
+    {"ntp",     "enabled",        JSON_READER_BOOL}
+};
+
+enum BackupSection : uint8_t {
+    BS_NETWORK,
+    BS_DEVICE,
+    BS_USER,
+    BS_NTP,
+    BS_COUNT
+};
+
+static const char* const BACKUP_SECTIONS[BS_COUNT] = {"network", "device", "user", "ntp"};
+
+// Yedek okuyucu - akıştan sadece bilinen alanları sabit tamponlara alır.
+// Tipi uymayan alan yokmuş gibi sayılır (varsayılan değer kullanılır).
+class BackupReader : public JsonReader {
+public:
+    void begin() {
+        reset();
+        sections = 0;
+        present = 0;
+    }
     
-    // Log ayarları
-    JsonObject logging = doc["logging"].to<JsonObject>();
-    logging["maxLogs"] = 50;
-    logging["currentLogs"] = totalLogs;
+    bool hasSection(BackupSection section) const { return sections & (1 << section); }
     
-    // Sistem bilgileri
-    JsonObject system = doc["system"].to<JsonObject>();
-    system["freeHeap"] = ESP.getFreeHeap();
-    system["chipRevision"] = ESP.getChipRevision();
-    system["sdkVersion"] = ESP.getSdkVersion();
-    system["flashSize"] = ESP.getFlashChipSize();
+    const char* get(BackupFieldId id, const char* fallback) const {
+        return (present & (1 << id)) ? values[id] : fallback;
+    }
     
-    // JSON'u string'e serialize et
-    String output;
-    serializeJsonPretty(doc, output);
+    long getLong(BackupFieldId id, long fallback) const {
+        return (present & (1 << id)) ? strtol(values[id], NULL, 10) : fallback;
+    }
     
-    addLog("✅ Ayarlar JSON formatında export edildi", SUCCESS, "BACKUP");
-    return output;
-}
+    bool getBool(BackupFieldId id, bool fallback) const {
+        return (present & (1 << id)) ? values[id][0] == 't' : fallback;
+    }
 
-// JSON'dan ayarları import et
-bool importSettingsFromJSON(const String& jsonData) {
-    // JSON parse et - Yeni ArduinoJson v7 syntax
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, jsonData);
-    
-    if (error) {
-        addLog("❌ JSON parse hatası: " + String(error.c_str()), ERROR, "RESTORE");
-        return false;
+protected:
+    void onObjectStart() override {
+        if (depth() != 1) return;
+        for (uint8_t i = 0; i < BS_COUNT; i++) {
+            if (strcmp(key(0), BACKUP_SECTIONS[i]) == 0) {
+                sections |= 1 << i;
+            }
+        }
     }
     
+    void onValue(JsonReaderType type, const char* text, size_t length) override {
+        for (uint8_t i = 0; i < BF_COUNT; i++) {
+            const BackupField& field = BACKUP_FIELDS[i];
+            bool match = field.section == NULL
+                ? depth() == 1 && strcmp(key(0), field.key) == 0
+                : depth() == 2 && strcmp(key(0), field.section) == 0 &&
+                  strcmp(key(1), field.key) == 0;
+            if (!match) continue;
+            
+            if (type == field.type && length <= BACKUP_MAX_VALUE) {
+                memcpy(values[i], text, length + 1);
+                present |= 1 << i;
+            } else {
+                present &= ~(1 << i);
+            }
+            return;
+        }
+    }
+
+private:
+    uint8_t sections;
+    uint16_t present;
+    char values[BF_COUNT][BACKUP_MAX_VALUE + 1];
+};
+
+// Yükleme sırasındaki okuyucu - tek oturum olduğu için tek yükleme
+static BackupReader uploadReader;
+
+// Okunan yedeği uygula - sadece belge baştan sona geçerliyse çağrılır
+static bool applyBackup(const BackupReader& backup) {
     // Versiyon kontrolü
-    String version = doc["version"] | "unknown";
+    String version = backup.get(BF_VERSION, "unknown");
     if (version != "1.0") {
-        addLog("⚠️ Uyumsuz backup versiyonu: " + version, WARN, "RESTORE");
+        LOGW(LOG_SRC_RESTORE, LT_RESTORE_VERSION_MISMATCH, version);
     }
     
     // Preferences'ı aç
     Preferences prefs;
     prefs.begin("app-settings", false);
     
-    try {
-        // Network ayarlarını yükle
-        if (doc["network"].is<JsonObject>()) {
-            JsonObject network = doc["network"];
-            
-            String ipStr = network["localIP"] | "192.168.1.160";
-            String gwStr = network["gateway"] | "192.168.1.1";
-            String snStr = network["subnet"] | "255.255.255.0";
-            String dnsStr = network["dns"] | "8.8.8.8";
-            
-            // IP validasyonu ve kaydetme
-            IPAddress testIP;
-            if (testIP.fromString(ipStr)) {
-                prefs.putString("local_ip", ipStr);
-                settings.local_IP.fromString(ipStr);
-            }
-            if (testIP.fromString(gwStr)) {
-                prefs.putString("gateway", gwStr);
-                settings.gateway.fromString(gwStr);
-            }
-            if (testIP.fromString(snStr)) {
-                prefs.putString("subnet", snStr);
-                settings.subnet.fromString(snStr);
-            }
-            if (testIP.fromString(dnsStr)) {
-                prefs.putString("dns", dnsStr);
-                settings.primaryDNS.fromString(dnsStr);
-            }
-        }
+    // Network ayarlarını yükle
+    if (backup.hasSection(BS_NETWORK)) {
+        String ipStr = backup.get(BF_LOCAL_IP, "192.168.1.160");
+        String gwStr = backup.get(BF_GATEWAY, "192.168.1.1");
+        String snStr = backup.get(BF_SUBNET, "255.255.255.0");
+        String dnsStr = backup.get(BF_DNS, "8.8.8.8");
         
-        // Cihaz bilgilerini yükle
-        if (doc["device"].is<JsonObject>()) {
-            JsonObject device = doc["device"];
-            
-            String devName = device["name"] | "TEİAŞ EKLİM";
-            String tmName = device["tmName"] | "Belirtilmemiş";
-            long baudRate = device["baudRate"] | 115200;
-            
-            prefs.putString("dev_name", devName);
-            prefs.putString("tm_name", tmName);
-            prefs.putLong("baudrate", baudRate);
-            
-            settings.deviceName = devName;
-            settings.transformerStation = tmName;
-            settings.currentBaudRate = baudRate;
+        // IP validasyonu ve kaydetme
+        IPAddress testIP;
+        if (testIP.fromString(ipStr)) {
+            prefs.putString("local_ip", ipStr);
+            settings.local_IP.fromString(ipStr);
         }
-        
-        // Kullanıcı ayarlarını yükle (şifre hariç)
-        if (doc["user"].is<JsonObject>()) {
-            JsonObject user = doc["user"];
-            
-            String username = user["username"] | "admin";
-            unsigned long timeout = user["sessionTimeout"] | 1800000;
-            
-            prefs.putString("username", username);
-            settings.username = username;
-            settings.SESSION_TIMEOUT = timeout;
+        if (testIP.fromString(gwStr)) {
+            prefs.putString("gateway", gwStr);
+            settings.gateway.fromString(gwStr);
         }
-        
-        // NTP ayarlarını yükle
-        if (doc["ntp"].is<JsonObject>()) {
-            JsonObject ntp = doc["ntp"];
-            
-            String server1 = ntp["server1"] | "pool.ntp.org";
-            String server2 = ntp["server2"] | "time.google.com";
-            int timezone = ntp["timezone"] | 3;
-            bool enabled = ntp["enabled"] | true;
-            
-            // NTP ayarlarını kaydet
-            Preferences ntpPrefs;
-            ntpPrefs.begin("ntp-config", false);
-            ntpPrefs.putString("ntp_server1", server1);
-            ntpPrefs.putString("ntp_server2", server2);
-            ntpPrefs.putInt("timezone", timezone);
-            ntpPrefs.putBool("enabled", enabled);
-            ntpPrefs.end();
-            
-            // Global NTP config'i güncelle
-            server1.toCharArray(ntpConfig.ntpServer1, sizeof(ntpConfig.ntpServer1));
-            server2.toCharArray(ntpConfig.ntpServer2, sizeof(ntpConfig.ntpServer2));
-            ntpConfig.timezone = timezone;
-            ntpConfig.enabled = enabled;
+        if (testIP.fromString(snStr)) {
+            prefs.putString("subnet", snStr);
+            settings.subnet.fromString(snStr);
+        }
+        if (testIP.fromString(dnsStr)) {
+            prefs.putString("dns", dnsStr);
+            settings.primaryDNS.fromString(dnsStr);
         }
+    }
+    
+    // Cihaz bilgilerini yükle
+    if (backup.hasSection(BS_DEVICE)) {
+        String devName = backup.get(BF_DEV_NAME, "TEİAŞ EKLİM");
+        String tmName = backup.get(BF_TM_NAME, "Belirtilmemiş");
+        long baudRate = backup.getLong(BF_BAUD_RATE, 115200);
         
-        prefs.end();
+        prefs.putString("dev_name", devName);
+        prefs.putString("tm_name", tmName);
+        prefs.putLong("baudrate", baudRate);
         
-        addLog("✅ Ayarlar başarıyla import edildi", SUCCESS, "RESTORE");
-        addLog("⚠️ Yeniden başlatma gerekli", WARN, "RESTORE");
+        settings.deviceName = devName;
+        settings.transformerStation = tmName;
+        settings.currentBaudRate = baudRate;
+    }
+    
+    // Kullanıcı ayarlarını yükle (şifre hariç)
+    if (backup.hasSection(BS_USER)) {
+        String username = backup.get(BF_USERNAME, "admin");
+        unsigned long timeout = (unsigned long)backup.getLong(BF_SESSION_TIMEOUT, 1800000);
         
-        return true;
+        prefs.putString("username", username);
+        settings.username = username;
+        settings.SESSION_TIMEOUT = timeout;
+    }
+    
+    // NTP ayarlarını yükle
+    if (backup.hasSection(BS_NTP)) {
+        String server1 = backup.get(BF_NTP_SERVER1, "pool.ntp.org");
+        String server2 = backup.get(BF_NTP_SERVER2, "time.google.com");
+        int timezone = (int)backup.getLong(BF_TIMEZONE, 3);
+        bool enabled = backup.getBool(BF_NTP_ENABLED, true);
+        
+        // NTP ayarlarını kaydet
+        Preferences ntpPrefs;
+        ntpPrefs.begin("ntp-config", false);
+        ntpPrefs.putString("ntp_server1", server1);
+        ntpPrefs.putString("ntp_server2", server2);
+        ntpPrefs.putInt("timezone", timezone);
+        ntpPrefs.putBool("enabled", enabled);
+        ntpPrefs.end();
         
-    } catch (...) {
-        prefs.end();
-        addLog("❌ Ayarlar import edilemedi", ERROR, "RESTORE");
+        // Global NTP config'i güncelle
+        server1.toCharArray(ntpConfig.ntpServer1, sizeof(ntpConfig.ntpServer1));
+        server2.toCharArray(ntpConfig.ntpServer2, sizeof(ntpConfig.ntpServer2));
+        ntpConfig.timezone = timezone;
+        ntpConfig.enabled = enabled;
+    }
+    
+    prefs.end();
+    bumpConfigVersion();
+    
+    LOGS(LOG_SRC_RESTORE, LT_RESTORE_IMPORTED);
+    LOGW(LOG_SRC_RESTORE, LT_RESTORE_RESTART_REQUIRED);
+    
+    return true;
+}
+
+// Okumayı bitir ve geçerliyse uygula
+static bool finishBackup(BackupReader& backup) {
+    if (!backup.finish()) {
+        LOGE(LOG_SRC_RESTORE, LT_RESTORE_PARSE_ERROR, backup.errorMessage());
         return false;
     }
+    return applyBackup(backup);
+}
+
+// JSON'dan ayarları import et
+bool importSettingsFromJSON(const String& jsonData) {
+    BackupReader* backup = new BackupReader();
+    backup->begin();
+    backup->feed((const uint8_t*)jsonData.c_str(), jsonData.length());
+    bool ok = finishBackup(*backup);
+    delete backup;
+    return ok;
 }
 
 // Backup dosyasını kaydet
@@ -193,14 +356,14 @@ bool saveBackupToFile(const String& filename) {
     // Dosyaya yaz
     File file = LittleFS.open("/" + filename, "w");
     if (!file) {
-        addLog("❌ Backup dosyası oluşturulamadı: " + filename, ERROR, "BACKUP");
+        LOGE(LOG_SRC_BACKUP, LT_BACKUP_FILE_CREATE_FAILED, filename);
         return false;
     }
     
     file.print(jsonBackup);
     file.close();
     
-    addLog("✅ Backup dosyası kaydedildi: " + filename, SUCCESS, "BACKUP");
+    LOGS(LOG_SRC_BACKUP, LT_BACKUP_FILE_SAVED, filename);
     return true;
 }
 
@@ -209,75 +372,112 @@ bool loadBackupFromFile(const String& filename) {
     // Dosyayı aç
     File file = LittleFS.open("/" + filename, "r");
     if (!file) {
-        addLog("❌ Backup dosyası bulunamadı: " + filename, ERROR, "RESTORE");
+        LOGE(LOG_SRC_RESTORE, LT_RESTORE_FILE_NOT_FOUND, filename);
         return false;
     }
     
-    // JSON'u oku
-    String jsonData = file.readString();
+    // Dosyayı parça parça oku - okuyucu ilk hatada durur
+    BackupReader* backup = new BackupReader();
+    backup->begin();
+    uint8_t chunk[BACKUP_READ_CHUNK];
+    size_t total = 0;
+    while (file.available() && !backup->failed()) {
+        size_t n = file.read(chunk, sizeof(chunk));
+        if (n == 0) break;
+        total += n;
+        if (total > BACKUP_MAX_UPLOAD) {
+            LOGE(LOG_SRC_RESTORE, LT_RESTORE_PARSE_ERROR, "Dosya çok büyük");
+            file.close();
+            delete backup;
+            return false;
+        }
+        backup->feed(chunk, n);
+    }
     file.close();
     
     // Import et
-    return importSettingsFromJSON(jsonData);
+    bool ok = finishBackup(*backup);
+    delete backup;
+    return ok;
 }
 
 // Web API handler - Backup indir
-void handleBackupDownload() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+void handleBackupDownload(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    // JSON backup oluştur
-    String jsonBackup = exportSettingsToJSON();
+    // JSON backup'ı gönderim sırasında bölüm bölüm yanıta yaz
+    JsonStepResponse* body = new JsonStepResponse(writeSettingsBackup);
     
     // Dosya adı oluştur
-    String filename = "teias_backup_" + String(millis()) + ".json";
+    char disposition[64];
+    snprintf(disposition, sizeof(disposition), "attachment; filename=\"teias_backup_%lu.json\"", millis());
+    sendChunked(request, "application/json", body, 200, disposition);
     
-    // HTTP response headers
-    server.sendHeader("Content-Type", "application/json");
-    server.sendHeader("Content-Disposition", "attachment; filename=\"" + filename + "\"");
-    server.sendHeader("Content-Length", String(jsonBackup.length()));
+    LOGI(LOG_SRC_BACKUP, LT_BACKUP_DOWNLOADED);
+}
+
+// Web API handler - Backup yükleme parçaları. Her parça geldiği anda
+// okuyucuya verilir, gövde biriktirilmez. Ayarlar istek tamamlanınca ve
+// belge baştan sona geçerliyse handleBackupUpload'da uygulanır.
+void handleBackupUploadData(AsyncWebServerRequest* request, const String& filename,
+                            size_t index, uint8_t* data, size_t len, bool final) {
+    if (index == 0) {
+        if (!checkSession(request) || request->_tempObject != NULL) return;
+        BackupUpload* upload = (BackupUpload*)malloc(sizeof(BackupUpload));
+        if (upload == NULL) return;
+        upload->id = ++uploadId;
+        upload->received = 0;
+        upload->overflow = false;
+        request->_tempObject = upload;
+        uploadReader.begin();
+        LOGI(LOG_SRC_RESTORE, LT_RESTORE_UPLOAD_STARTED, filename);
+    }
     
-    // JSON'u gönder
-    server.send(200, "application/json", jsonBackup);
+    // Sonradan başlayan bir yükleme okuyucuyu devraldıysa bu yükleme düşer
+    BackupUpload* upload = (BackupUpload*)request->_tempObject;
+    if (upload == NULL || upload->id != uploadId || upload->overflow || uploadReader.failed()) return;
     
-    addLog("📥 Backup indirildi", INFO, "BACKUP");
+    upload->received += len;
+    if (upload->received > BACKUP_MAX_UPLOAD) {
+        upload->overflow = true;
+        return;
+    }
+    uploadReader.feed(data, len);
 }
 
-// Web API handler - Backup yükle
-void handleBackupUpload() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+// Web API handler - Backup yükle (gövde tamamen alındıktan sonra)
+void handleBackupUpload(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    HTTPUpload& upload = server.upload();
-    static String uploadedData = "";
+    BackupUpload* upload = (BackupUpload*)request->_tempObject;
+    if (upload == NULL || upload->id != uploadId || upload->overflow) {
+        request->send(400, "text/plain", "Backup restore failed");
+        return;
+    }
     
-    if (upload.status == UPLOAD_FILE_START) {
-        uploadedData = "";
-        addLog("📤 Backup yükleme başladı: " + upload.filename, INFO, "RESTORE");
-        
-    } else if (upload.status == UPLOAD_FILE_WRITE) {
-        // Veriyi biriktir
-        for (size_t i = 0; i < upload.currentSize; i++) {
-            uploadedData += (char)upload.buf[i];
-        }
-        
-    } else if (upload.status == UPLOAD_FILE_END) {
-        // Import işlemini başlat
-        if (importSettingsFromJSON(uploadedData)) {
-            server.send(200, "text/plain", "Backup successfully restored. Device will restart.");
-            
-            // 2 saniye sonra restart
-            delay(2000);
-            ESP.restart();
-        } else {
-            server.send(400, "text/plain", "Backup restore failed");
-        }
-        
-        uploadedData = "";
+    // Import işlemini başlat
+    bool ok = finishBackup(uploadReader);
+    
+    if (ok) {
+        request->send(200, "text/plain", "Backup successfully restored. Device will restart.");
+        // Restart loop()'ta yapılır - yanıtın gitmesi beklenirken sunucu bloklanmaz
+        restartAt = millis();
+    } else {
+        request->send(400, "text/plain", "Backup restore failed");
+    }
+}
+
+// Planlanmış yeniden başlatma - loop()'tan çağrılır
+void checkPendingRestart() {
+    if (restartAt != 0 && millis() - restartAt > RESTART_DELAY) {
+        flushLogStorage();
+        ESP.restart();
     }
 }
 
@@ -313,13 +513,13 @@ void createAutomaticBackup() {
         // 7'den fazla backup varsa en eskisini sil
         if (backupCount >= 7 && oldestBackup != "") {
             LittleFS.remove("/" + oldestBackup);
-            addLog("🗑️ Eski backup silindi: " + oldestBackup, INFO, "BACKUP");
+            LOGI(LOG_SRC_BACKUP, LT_BACKUP_OLD_REMOVED, oldestBackup);
         }
         
         // Yeni backup oluştur
         if (saveBackupToFile(filename)) {
             lastBackup = millis();
-            addLog("💾 Otomatik backup oluşturuldu", SUCCESS, "BACKUP");
+            LOGS(LOG_SRC_BACKUP, LT_BACKUP_AUTO_CREATED);
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#include "chunked_response.h"
+#include "log_system.h"
+#include <ESPAsyncWebServer.h>
+#include <memory>
+
+ChunkedSource::ChunkedSource()
+    : length(0), offset(0), finished(false), overflow(false), route(activeHttpRoute()), sent(0) {}
+
+size_t ChunkedSource::write(uint8_t c) {
+    return write(&c, 1);
+}
+
+// Tampon büyümez: sığmayan parça üreticiyi durdurur
+size_t ChunkedSource::write(const uint8_t* data, size_t size) {
+    if (overflow) return 0;
+    if (length + size > CHUNK_BUFFER_SIZE) {
+        overflow = true;
+        LOGE(LOG_SRC_WEB, LT_WEB_CHUNK_OVERFLOW, CHUNK_BUFFER_SIZE);
+        return 0;
+    }
+    memcpy(staging + length, data, size);
+    length += size;
+    return size;
+}
+
+// Sunucu tamponunu doldur: tampon boşaldıkça sıradaki parça üretilir.
+// Taşma olduysa yarım parça gönderilmez, yanıt biter.
+size_t ChunkedSource::fill(uint8_t* buffer, size_t maxLen) {
+    size_t total = 0;
+    while (total < maxLen && !overflow) {
+        if (offset >= length) {
+            if (finished) break;
+            length = 0;
+            offset = 0;
+            finished = !step();
+            continue;
+        }
+        size_t n = min(maxLen - total, length - offset);
+        memcpy(buffer + total, staging + offset, n);
+        offset += n;
+        total += n;
+    }
+    sent += total;
+    return total;
+}
+
+void sendChunked(AsyncWebServerRequest* request, const char* contentType, ChunkedSource* source,
+                 int code, const char* disposition) {
+    std::shared_ptr<ChunkedSource> state(source);
+    AsyncWebServerResponse* response = request->beginChunkedResponse(contentType,
+        [state](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            return state->fill(buffer, maxLen);
+        });
+    response->setCode(code);
+    if (disposition != NULL) {
+        response->addHeader("Content-Disposition", disposition);
+    }
+    request->send(response);
+}
+
+// Gövde başlıklardan önce tamamen yazılmış olur; taşmışsa yarım JSON yerine hata
+void sendJson(AsyncWebServerRequest* request, JsonResponse* body, int code) {
+    if (body->overflowed()) {
+        delete body;
+        sendJsonError(request, 500, "Yanıt tampona sığmadı");
+        return;
+    }
+    sendChunked(request, "application/json", body, code);
+}
+
+void sendJsonSteps(AsyncWebServerRequest* request, JsonStepWriter writer, int code) {
+    sendChunked(request, "application/json", new JsonStepResponse(writer), code);
+}
+
+void writeJsonSteps(JsonWriter& json, JsonStepWriter writer) {
+    for (uint16_t index = 0; writer(json, index); index++) {}
+}
+
+void sendJsonError(AsyncWebServerRequest* request, int code, const char* message) {
+    JsonResponse* body = new JsonResponse();
+    body->json.beginObject();
+    body->json.field("error", message);
+    body->json.endObject();
+    sendJson(request, body, code);
+}
+
+void sendJsonResult(AsyncWebServerRequest* request, int code, bool success, const char* message) {
+    JsonResponse* body = new JsonResponse();
+    body->json.beginObject();
+    body->json.field("success", success);
+    body->json.field("message", message);
+    body->json.endObject();
+    sendJson(request, body, code);
+}
@@ -1,6 +1,7 @@
 #include "crypto_utils.h"
 #include "mbedtls/sha256.h"
 #include <Arduino.h>
+#include <bootloader_random.h>
 
 String sha256(const String& data, const String& salt) {
     // Input validation
@@ -68,4 +69,10 @@ bool isPasswordStrong(const String& password) {
     // En az 2 farklı karakter türü olsun
     int score = hasUpper + hasLower + hasDigit;
     return score >= 2;
-}
\ No newline at end of file
+}
+
+void fillSecureRandom(uint8_t* buffer, size_t length) {
+    bootloader_random_enable();
+    esp_fill_random(buffer, length);
+    bootloader_random_disable();
+}
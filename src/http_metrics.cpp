@@ -0,0 +1,119 @@
+#include "http_metrics.h"
+#include <ESPAsyncWebServer.h>
+#include <esp_timer.h>
+
+static HttpRouteMetrics routes[HTTP_METRICS_MAX_ROUTES];
+static uint8_t routeCount = 0;
+static HttpRouteMetrics* activeRoute = NULL;
+
+HttpRouteMetrics* registerHttpRouteMetrics(const char* route, uint8_t method) {
+    if (routeCount >= HTTP_METRICS_MAX_ROUTES) return NULL;
+    
+    HttpRouteMetrics* metrics = &routes[routeCount++];
+    memset(metrics, 0, sizeof(HttpRouteMetrics));
+    metrics->route = route;
+    metrics->method = method;
+    return metrics;
+}
+
+int64_t beginHttpRequest(HttpRouteMetrics* route) {
+    activeRoute = route;
+    return esp_timer_get_time();
+}
+
+// Kova i, [32·2^i, 64·2^i) µs aralığını tutar; son kova üstü açık
+static uint8_t latencyBucket(uint32_t us) {
+    if (us < (1UL << HTTP_LATENCY_MIN_SHIFT)) return 0;
+    uint8_t bucket = 31 - __builtin_clz(us) - HTTP_LATENCY_MIN_SHIFT + 1;
+    return bucket < HTTP_LATENCY_BUCKETS ? bucket : HTTP_LATENCY_BUCKETS - 1;
+}
+
+void endHttpHandler() {
+    activeRoute = NULL;
+}
+
+void endHttpRequest(HttpRouteMetrics* route, int64_t startUs, int statusCode) {
+    if (route == NULL) return;
+    
+    int64_t elapsed = esp_timer_get_time() - startUs;
+    uint32_t us = elapsed > 0xFFFFFFFFLL ? 0xFFFFFFFFUL : (uint32_t)elapsed;
+    
+    route->count++;
+    if (statusCode >= 100 && statusCode < 600) {
+        route->status[statusCode / 100 - 1]++;
+    }
+    route->totalUs += us;
+    if (us > route->maxUs) route->maxUs = us;
+    route->latency[latencyBucket(us)]++;
+}
+
+HttpRouteMetrics* activeHttpRoute() {
+    return activeRoute;
+}
+
+void addHttpRouteBytes(HttpRouteMetrics* route, size_t bytes) {
+    if (route != NULL) route->bytes += bytes;
+}
+
+static const char* methodToString(uint8_t method) {
+    switch (method) {
+        case HTTP_GET:  return "GET";
+        case HTTP_POST: return "POST";
+        default:        return "ANY";
+    }
+}
+
+// Parça 0: başlık, 1..routeCount: birer rota, sonra kapanış
+bool writeHttpMetricsJson(JsonWriter& json, uint16_t index) {
+    static const char* STATUS_KEYS[5] = {"1xx", "2xx", "3xx", "4xx", "5xx"};
+    
+    if (index == 0) {
+        json.beginObject();
+        json.field("uptimeMs", (unsigned long)millis());
+        
+        // Her kovanın alt sınırı (µs)
+        json.key("bucketsUs");
+        json.beginArray();
+        json.value(0UL);
+        for (int i = 1; i < HTTP_LATENCY_BUCKETS; i++) {
+            json.value((unsigned long)(1UL << (HTTP_LATENCY_MIN_SHIFT + i - 1)));
+        }
+        json.endArray();
+        
+        json.key("routes");
+        json.beginArray();
+        return true;
+    }
+    
+    if (index <= routeCount) {
+        const HttpRouteMetrics& r = routes[index - 1];
+        json.beginObject();
+        json.field("route", r.route);
+        json.field("method", methodToString(r.method));
+        json.field("count", (unsigned long)r.count);
+        
+        json.key("status");
+        json.beginObject();
+        for (int s = 0; s < 5; s++) {
+            if (r.status[s] > 0) json.field(STATUS_KEYS[s], (unsigned long)r.status[s]);
+        }
+        json.endObject();
+        
+        json.field("bytes", (unsigned long)r.bytes);
+        json.field("avgUs", (unsigned long)(r.count > 0 ? r.totalUs / r.count : 0));
+        json.field("maxUs", (unsigned long)r.maxUs);
+        
+        json.key("latency");
+        json.beginArray();
+        for (int b = 0; b < HTTP_LATENCY_BUCKETS; b++) {
+            json.value((unsigned long)r.latency[b]);
+        }
+        json.endArray();
+        json.endObject();
+        return true;
+    }
+    
+    json.endArray();
+    json.endObject();
+    return false;
+}
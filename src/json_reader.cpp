@@ -0,0 +1,252 @@
+#include "json_reader.h"
+
+JsonReader::JsonReader() {
+    reset();
+}
+
+void JsonReader::reset() {
+    state = READ_VALUE;
+    stringIsKey = false;
+    level = 0;
+    tokenLength = 0;
+    unicode = 0;
+    unicodeDigits = 0;
+    highSurrogate = 0;
+    error = NULL;
+}
+
+bool JsonReader::feed(const uint8_t* data, size_t length) {
+    if (error) return false;
+    for (size_t i = 0; i < length; i++) {
+        if (!step((char)data[i])) return false;
+    }
+    return true;
+}
+
+bool JsonReader::finish() {
+    if (error) return false;
+    // Kök seviyede tek başına sayı: sonlandırıcı karakter gelmez
+    if (state == READ_LITERAL && level == 0 && !endLiteral()) return false;
+    if (state != READ_DONE) return fail("Belge eksik");
+    return true;
+}
+
+bool JsonReader::fail(const char* message) {
+    if (!error) error = message;
+    return false;
+}
+
+bool JsonReader::append(char c) {
+    if (highSurrogate) return fail("Eksik UTF-16 çifti");
+    if (tokenLength >= JSON_READER_MAX_TOKEN) return fail("Değer çok uzun");
+    token[tokenLength++] = c;
+    return true;
+}
+
+// \uXXXX kaçışını UTF-8 olarak ekle (vekil çiftler birleştirilir)
+bool JsonReader::appendCodepoint(uint32_t cp) {
+    if (cp >= 0xD800 && cp < 0xDC00) {
+        if (highSurrogate) return fail("Eksik UTF-16 çifti");
+        highSurrogate = cp;
+        return true;
+    }
+    if (cp >= 0xDC00 && cp < 0xE000) {
+        if (!highSurrogate) return fail("Eksik UTF-16 çifti");
+        cp = 0x10000 + ((uint32_t)(highSurrogate - 0xD800) << 10) + (cp - 0xDC00);
+        highSurrogate = 0;
+    }
+    if (cp < 0x80) return append((char)cp);
+    if (cp < 0x800) {
+        return append((char)(0xC0 | (cp >> 6))) &&
+               append((char)(0x80 | (cp & 0x3F)));
+    }
+    if (cp < 0x10000) {
+        return append((char)(0xE0 | (cp >> 12))) &&
+               append((char)(0x80 | ((cp >> 6) & 0x3F))) &&
+               append((char)(0x80 | (cp & 0x3F)));
+    }
+    return append((char)(0xF0 | (cp >> 18))) &&
+           append((char)(0x80 | ((cp >> 12) & 0x3F))) &&
+           append((char)(0x80 | ((cp >> 6) & 0x3F))) &&
+           append((char)(0x80 | (cp & 0x3F)));
+}
+
+bool JsonReader::step(char c) {
+    switch (state) {
+        case READ_STRING:
+            if (c == '"') return endString();
+            if (c == '\\') {
+                state = READ_ESCAPE;
+                return true;
+            }
+            if ((uint8_t)c < 0x20) return fail("Dizede kontrol karakteri");
+            return append(c);
+
+        case READ_ESCAPE:
+            state = READ_STRING;
+            switch (c) {
+                case '"':
+                case '\\':
+                case '/': return append(c);
+                case 'b': return append('\b');
+                case 'f': return append('\f');
+                case 'n': return append('\n');
+                case 'r': return append('\r');
+                case 't': return append('\t');
+                case 'u':
+                    unicode = 0;
+                    unicodeDigits = 0;
+                    state = READ_UNICODE;
+                    return true;
+                default: return fail("Geçersiz kaçış");
+            }
+
+        case READ_UNICODE: {
+            uint8_t digit;
+            if (c >= '0' && c <= '9') digit = c - '0';
+            else if (c >= 'a' && c <= 'f') digit = c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') digit = c - 'A' + 10;
+            else return fail("Geçersiz kaçış");
+            unicode = (unicode << 4) | digit;
+            if (++unicodeDigits < 4) return true;
+            state = READ_STRING;
+            return appendCodepoint(unicode);
+        }
+
+        case READ_LITERAL:
+            if (isalnum((uint8_t)c) || c == '-' || c == '+' || c == '.') {
+                return append(c);
+            }
+            // Sonlandırıcı karakter değerden sonraki durumda işlenir
+            return endLiteral() && step(c);
+
+        default:
+            break;
+    }
+
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r') return true;
+
+    switch (state) {
+        case READ_VALUE_OR_END:
+            if (c == ']') return closeContainer('[');
+            return beginValue(c);
+
+        case READ_VALUE:
+            return beginValue(c);
+
+        case READ_KEY_OR_END:
+            if (c == '}') return closeContainer('{');
+            // fall through
+        case READ_KEY:
+            if (c != '"') return fail("Anahtar bekleniyor");
+            stringIsKey = true;
+            tokenLength = 0;
+            state = READ_STRING;
+            return true;
+
+        case READ_COLON:
+            if (c != ':') return fail("':' bekleniyor");
+            state = READ_VALUE;
+            return true;
+
+        case READ_AFTER_VALUE:
+            if (c == ',') {
+                state = stack[level - 1] == '{' ? READ_KEY : READ_VALUE;
+                return true;
+            }
+            if (c == '}') return closeContainer('{');
+            if (c == ']') return closeContainer('[');
+            return fail("',' bekleniyor");
+
+        default:
+            return fail("Belge sonunda fazla veri");
+    }
+}
+
+bool JsonReader::beginValue(char c) {
+    if (c == '{' || c == '[') {
+        if (level >= JSON_READER_MAX_DEPTH) return fail("Belge çok derin");
+        if (c == '{') onObjectStart();
+        stack[level] = c;
+        keys[level][0] = '\0';
+        level++;
+        state = c == '{' ? READ_KEY_OR_END : READ_VALUE_OR_END;
+        return true;
+    }
+    tokenLength = 0;
+    if (c == '"') {
+        stringIsKey = false;
+        state = READ_STRING;
+        return true;
+    }
+    if (c == '-' || isalnum((uint8_t)c)) {
+        state = READ_LITERAL;
+        return append(c);
+    }
+    return fail("Değer bekleniyor");
+}
+
+bool JsonReader::endValue() {
+    state = level == 0 ? READ_DONE : READ_AFTER_VALUE;
+    return true;
+}
+
+bool JsonReader::closeContainer(char open) {
+    if (level == 0 || stack[level - 1] != open) return fail("Parantez uyuşmuyor");
+    level--;
+    return endValue();
+}
+
+bool JsonReader::endString() {
+    if (highSurrogate) return fail("Eksik UTF-16 çifti");
+    token[tokenLength] = '\0';
+
+    if (stringIsKey) {
+        if (tokenLength > JSON_READER_MAX_KEY) return fail("Anahtar çok uzun");
+        memcpy(keys[level - 1], token, tokenLength + 1);
+        state = READ_COLON;
+        return true;
+    }
+
+    onValue(JSON_READER_STRING, token, tokenLength);
+    return endValue();
+}
+
+// true/false/null ya da sayı - sayı biçimi JSON dilbilgisine göre denetlenir
+bool JsonReader::endLiteral() {
+    token[tokenLength] = '\0';
+
+    if (strcmp(token, "true") == 0 || strcmp(token, "false") == 0) {
+        onValue(JSON_READER_BOOL, token, tokenLength);
+        return endValue();
+    }
+    if (strcmp(token, "null") == 0) {
+        onValue(JSON_READER_NULL, token, tokenLength);
+        return endValue();
+    }
+
+    const char* p = token;
+    if (*p == '-') p++;
+    if (*p == '0') {
+        p++;
+    } else if (*p >= '1' && *p <= '9') {
+        while (isdigit((uint8_t)*p)) p++;
+    } else {
+        return fail("Geçersiz değer");
+    }
+    if (*p == '.') {
+        p++;
+        if (!isdigit((uint8_t)*p)) return fail("Geçersiz sayı");
+        while (isdigit((uint8_t)*p)) p++;
+    }
+    if (*p == 'e' || *p == 'E') {
+        p++;
+        if (*p == '+' || *p == '-') p++;
+        if (!isdigit((uint8_t)*p)) return fail("Geçersiz sayı");
+        while (isdigit((uint8_t)*p)) p++;
+    }
+    if (*p != '\0') return fail("Geçersiz sayı");
+
+    onValue(JSON_READER_NUMBER, token, tokenLength);
+    return endValue();
+}
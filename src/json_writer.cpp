@@ -0,0 +1,117 @@
+#include "json_writer.h"
+
+JsonWriter::JsonWriter(Print& out)
+    : out(out), depth(0), hasItems(0), afterKey(false) {}
+
+// Aynı seviyedeki önceki elemandan sonra virgül koy
+void JsonWriter::separator() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    uint32_t bit = 1UL << (depth & 31);
+    if (hasItems & bit) {
+        out.write(',');
+    }
+    hasItems |= bit;
+}
+
+void JsonWriter::open(char c) {
+    separator();
+    out.write(c);
+    depth++;
+    hasItems &= ~(1UL << (depth & 31));
+}
+
+void JsonWriter::close(char c) {
+    out.write(c);
+    if (depth > 0) depth--;
+}
+
+void JsonWriter::beginObject() { open('{'); }
+void JsonWriter::endObject()   { close('}'); }
+void JsonWriter::beginArray()  { open('['); }
+void JsonWriter::endArray()    { close(']'); }
+
+void JsonWriter::key(const char* name) {
+    separator();
+    writeEscaped(name, strlen(name));
+    out.write(':');
+    afterKey = true;
+}
+
+void JsonWriter::value(const char* str) {
+    separator();
+    if (str == nullptr) {
+        out.print("null");
+        return;
+    }
+    writeEscaped(str, strlen(str));
+}
+
+void JsonWriter::value(const String& str) {
+    separator();
+    writeEscaped(str.c_str(), str.length());
+}
+
+void JsonWriter::value(long number) {
+    separator();
+    char buffer[12];
+    snprintf(buffer, sizeof(buffer), "%ld", number);
+    out.print(buffer);
+}
+
+void JsonWriter::value(unsigned long number) {
+    separator();
+    char buffer[12];
+    snprintf(buffer, sizeof(buffer), "%lu", number);
+    out.print(buffer);
+}
+
+void JsonWriter::value(bool flag) {
+    separator();
+    out.print(flag ? "true" : "false");
+}
+
+void JsonWriter::valueNull() {
+    separator();
+    out.print("null");
+}
+
+// Dizeyi tırnak içinde yaz. Kaçış gerektirmeyen bölümler tek seferde yazılır;
+// UTF-8 byte'ları (>= 0x80) olduğu gibi geçer.
+void JsonWriter::writeEscaped(const char* str, size_t length) {
+    out.write('"');
+
+    size_t runStart = 0;
+    for (size_t i = 0; i < length; i++) {
+        uint8_t c = (uint8_t)str[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        if (i > runStart) {
+            out.write((const uint8_t*)str + runStart, i - runStart);
+        }
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  out.print("\\\""); break;
+            case '\\': out.print("\\\\"); break;
+            case '\n': out.print("\\n"); break;
+            case '\r': out.print("\\r"); break;
+            case '\t': out.print("\\t"); break;
+            case '\b': out.print("\\b"); break;
+            case '\f': out.print("\\f"); break;
+            default: {
+                char buffer[7];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                out.print(buffer);
+                break;
+            }
+        }
+    }
+
+    if (length > runStart) {
+        out.write((const uint8_t*)str + runStart, length - runStart);
+    }
+    out.write('"');
+}
@@ -0,0 +1,151 @@
+#include "log_rtc.h"
+#include <esp_attr.h>
+#include <esp_system.h>
+#include <esp_rom_crc.h>
+
+// Sıkıştırılmış kayıt: 20 byte. Zaman sadece millis olarak tutulur,
+// gerçek zaman başlıktaki epochBase ile geri hesaplanır. Tekrar özeti
+// sayısıyla ve ilk tekrarın ne kadar önce olduğuyla saklanır.
+struct RtcLogEntry {
+    uint32_t millis_time;
+    uint16_t templateId;
+    uint16_t repeatCount;
+    uint16_t firstAgo;               // millis_time - firstMillis, 100 ms biriminde
+    uint8_t levelSource;             // Üst 4 bit seviye, alt 4 bit kaynak
+    uint8_t argLength;
+    uint8_t args[RTC_LOG_ARG_BYTES];
+    uint8_t check;                   // Kaydın CRC'sinin düşük byte'ı
+};
+
+struct RtcLogHeader {
+    uint32_t magic;
+    uint16_t head;                   // Sıradaki yazılacak yuva
+    uint16_t count;
+    uint32_t epochBase;              // millis 0 anındaki epoch (bilinmiyorsa 0)
+    uint32_t crc;                    // Üstteki alanların CRC'si
+};
+
+// Reset'te sıfırlanmayan RTC yavaş belleği (güç kesilince içerik rastgeledir)
+RTC_NOINIT_ATTR static RtcLogHeader rtcLogHeader;
+RTC_NOINIT_ATTR static RtcLogEntry rtcLogEntries[RTC_LOG_CAPACITY];
+
+static uint32_t headerCrc(const RtcLogHeader& header) {
+    return esp_rom_crc32_le(0, (const uint8_t*)&header, offsetof(RtcLogHeader, crc));
+}
+
+static uint8_t entryCheck(const RtcLogEntry& entry) {
+    return (uint8_t)esp_rom_crc32_le(0, (const uint8_t*)&entry, offsetof(RtcLogEntry, check));
+}
+
+// Argümanları tam olarak sığanlarla sınırla; metin argümanı kırpılabilir
+static uint8_t compactArgs(const LogEntry& entry, uint8_t* out) {
+    uint8_t in = 0;
+    uint8_t length = 0;
+
+    while (in + 1 < entry.argLength) {
+        uint8_t tag = entry.args[in];
+        if (tag == LOG_ARG_STR) {
+            if (length + 2 > RTC_LOG_ARG_BYTES) break;
+            uint8_t header = entry.args[in + 1];
+            uint8_t textLength = header & ~LOG_ARG_STR_TRUNCATED;
+            uint8_t room = RTC_LOG_ARG_BYTES - length - 2;
+            uint8_t copied = textLength;
+            if (copied > room) {
+                copied = room;
+                while (copied > 0 && (entry.args[in + 2 + copied] & 0xC0) == 0x80) copied--;
+                header = copied | LOG_ARG_STR_TRUNCATED;
+            }
+            out[length++] = tag;
+            out[length++] = header;
+            memcpy(out + length, entry.args + in + 2, copied);
+            length += copied;
+            in += 2 + textLength;
+        } else {
+            if (length + 5 > RTC_LOG_ARG_BYTES) break;
+            memcpy(out + length, entry.args + in, 5);
+            length += 5;
+            in += 5;
+        }
+    }
+    return length;
+}
+
+uint32_t beginRtcLog() {
+    if (rtcLogHeader.magic != RTC_LOG_MAGIC || rtcLogHeader.crc != headerCrc(rtcLogHeader)) {
+        return 0;  // İlk açılış / güç kesintisi / bozuk içerik
+    }
+    if (rtcLogHeader.head >= RTC_LOG_CAPACITY || rtcLogHeader.count > RTC_LOG_CAPACITY) {
+        return 0;
+    }
+    return rtcLogHeader.count;
+}
+
+bool readRtcLogEntry(uint32_t index, LogEntry& out) {
+    if (index >= rtcLogHeader.count) return false;
+
+    uint32_t slot = (rtcLogHeader.head + RTC_LOG_CAPACITY - rtcLogHeader.count + index) % RTC_LOG_CAPACITY;
+    const RtcLogEntry& entry = rtcLogEntries[slot];
+    if (entry.check != entryCheck(entry) || entry.argLength > RTC_LOG_ARG_BYTES) {
+        return false;  // Yazılırken reset gelmiş
+    }
+
+    memset(&out, 0, sizeof(out));
+    out.millis_time = entry.millis_time;
+    out.epoch = rtcLogHeader.epochBase ? rtcLogHeader.epochBase + entry.millis_time / 1000 : 0;
+    out.templateId = entry.templateId;
+    out.repeatCount = entry.repeatCount;
+    out.firstMillis = entry.millis_time - (uint32_t)entry.firstAgo * 100;
+    out.level = entry.levelSource >> 4;
+    out.source = entry.levelSource & 0x0F;
+    out.argLength = entry.argLength;
+    memcpy(out.args, entry.args, entry.argLength);
+    return true;
+}
+
+void resetRtcLog() {
+    rtcLogHeader.magic = RTC_LOG_MAGIC;
+    rtcLogHeader.head = 0;
+    rtcLogHeader.count = 0;
+    rtcLogHeader.epochBase = 0;
+    rtcLogHeader.crc = headerCrc(rtcLogHeader);
+}
+
+// Log kilidi altında çağrılır. Önce kayıt, sonra başlık yazılır; arada
+// reset gelirse başlık hâlâ eski durumu gösterir.
+void appendRtcLog(const LogEntry& entry) {
+    if (rtcLogHeader.magic != RTC_LOG_MAGIC) return;
+
+    RtcLogEntry& slot = rtcLogEntries[rtcLogHeader.head];
+    slot.millis_time = entry.millis_time;
+    slot.templateId = entry.templateId;
+    slot.repeatCount = entry.repeatCount;
+    uint32_t firstAgo = entry.repeatCount > 0 ? (entry.millis_time - entry.firstMillis) / 100 : 0;
+    slot.firstAgo = firstAgo > 0xFFFF ? 0xFFFF : firstAgo;
+    slot.levelSource = (entry.level << 4) | (entry.source & 0x0F);
+    memset(slot.args, 0, sizeof(slot.args));
+    slot.argLength = compactArgs(entry, slot.args);
+    slot.check = entryCheck(slot);
+
+    rtcLogHeader.head = (rtcLogHeader.head + 1) % RTC_LOG_CAPACITY;
+    if (rtcLogHeader.count < RTC_LOG_CAPACITY) rtcLogHeader.count++;
+    if (entry.epoch != 0) {
+        rtcLogHeader.epochBase = entry.epoch - entry.millis_time / 1000;
+    }
+    rtcLogHeader.crc = headerCrc(rtcLogHeader);
+}
+
+const char* resetReasonToString() {
+    switch (esp_reset_reason()) {
+        case ESP_RST_POWERON:   return "Güç açılışı";
+        case ESP_RST_EXT:       return "Harici reset";
+        case ESP_RST_SW:        return "Yazılım";
+        case ESP_RST_PANIC:     return "Panic";
+        case ESP_RST_INT_WDT:   return "Interrupt WDT";
+        case ESP_RST_TASK_WDT:  return "Task WDT";
+        case ESP_RST_WDT:       return "WDT";
+        case ESP_RST_DEEPSLEEP: return "Derin uyku";
+        case ESP_RST_BROWNOUT:  return "Brownout";
+        case ESP_RST_SDIO:      return "SDIO";
+        default:                return "Bilinmiyor";
+    }
+}
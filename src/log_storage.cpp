@@ -0,0 +1,238 @@
+#include "log_storage.h"
+#include "log_system.h"
+#include <LittleFS.h>
+
+// İki adet blok boyutunda tampon: biri doldurulurken diğeri flash'a yazılır.
+// Log çağıranlar sadece memcpy yapar, flash'a hiçbir zaman onlar yazmaz.
+static char flushBuffers[2][LOG_FLUSH_BLOCK_SIZE];
+static size_t bufferFill[2] = {0, 0};
+static int activeBuffer = 0;
+static int pendingBuffer = -1;   // Yazılmayı bekleyen tampon (-1: yok)
+static portMUX_TYPE storageMux = portMUX_INITIALIZER_UNLOCKED;
+
+static TaskHandle_t storageTaskHandle = NULL;
+static SemaphoreHandle_t fileMutex = NULL;
+
+// Segment durumu - sadece fileMutex altında değişir
+static uint32_t firstSegment = 0;
+static uint32_t currentSegment = 0;
+static uint32_t currentSegmentSize = 0;
+static bool storageReady = false;
+
+static uint32_t bytesWritten = 0;
+static uint32_t flushCount = 0;
+static volatile uint32_t droppedLines = 0;
+
+String getLogSegmentPath(uint32_t segment) {
+    char path[32];
+    snprintf(path, sizeof(path), LOG_STORAGE_DIR "/%08lu.log", (unsigned long)segment);
+    return String(path);
+}
+
+// Dosya adından segment numarasını çıkar ("00000012.log" -> 12)
+static bool parseSegmentNumber(const String& name, uint32_t& segment) {
+    int slash = name.lastIndexOf('/');
+    String base = slash >= 0 ? name.substring(slash + 1) : name;
+    if (!base.endsWith(".log") || base.length() != 12) return false;
+
+    segment = 0;
+    for (int i = 0; i < 8; i++) {
+        char c = base.charAt(i);
+        if (c < '0' || c > '9') return false;
+        segment = segment * 10 + (c - '0');
+    }
+    return true;
+}
+
+// Açılışta yazma konumunu bul. Sadece dizin girişleri ve dosya boyutları
+// okunur (LittleFS metadata), dosya içerikleri taranmaz.
+static void locateWritePosition() {
+    if (!LittleFS.exists(LOG_STORAGE_DIR)) {
+        LittleFS.mkdir(LOG_STORAGE_DIR);
+    }
+
+    bool found = false;
+    uint32_t minSegment = 0, maxSegment = 0;
+
+    File dir = LittleFS.open(LOG_STORAGE_DIR);
+    File file = dir.openNextFile();
+    while (file) {
+        uint32_t segment;
+        if (!file.isDirectory() && parseSegmentNumber(file.name(), segment)) {
+            if (!found || segment < minSegment) minSegment = segment;
+            if (!found || segment > maxSegment) {
+                maxSegment = segment;
+                currentSegmentSize = file.size();
+            }
+            found = true;
+        }
+        file = dir.openNextFile();
+    }
+
+    if (found) {
+        firstSegment = minSegment;
+        currentSegment = maxSegment;
+    } else {
+        firstSegment = 0;
+        currentSegment = 0;
+        currentSegmentSize = 0;
+    }
+}
+
+// Yeni segmente geç, sayı sınırını aşan en eski segmentleri sil
+static void rotateSegment() {
+    currentSegment++;
+    currentSegmentSize = 0;
+
+    while (currentSegment - firstSegment + 1 > LOG_SEGMENT_COUNT) {
+        LittleFS.remove(getLogSegmentPath(firstSegment));
+        firstSegment++;
+    }
+}
+
+// Tamponu segment dosyasına yaz (fileMutex alınmış olmalı)
+static void writeBlock(const char* data, size_t length) {
+    if (length == 0 || !storageReady) return;
+
+    if (currentSegmentSize + length > LOG_SEGMENT_SIZE && currentSegmentSize > 0) {
+        rotateSegment();
+    }
+
+    File file = LittleFS.open(getLogSegmentPath(currentSegment), "a");
+    if (!file) {
+        droppedLines++;
+        return;
+    }
+
+    size_t written = file.write((const uint8_t*)data, length);
+    file.close();
+
+    currentSegmentSize += written;
+    bytesWritten += written;
+    flushCount++;
+}
+
+// Aktif tamponu bekleyen tampon yap (storageMux alınmış olmalı)
+static bool swapBuffersLocked() {
+    if (pendingBuffer >= 0 || bufferFill[activeBuffer] == 0) return false;
+
+    pendingBuffer = activeBuffer;
+    activeBuffer ^= 1;
+    bufferFill[activeBuffer] = 0;
+    return true;
+}
+
+// Bekleyen tamponu (yoksa aktif tamponu) flash'a yaz ve serbest bırak.
+// fileMutex, aynı tamponun iki task tarafından yazılmasını da engeller.
+static void flushPendingBuffer() {
+    xSemaphoreTake(fileMutex, portMAX_DELAY);
+
+    int toFlush;
+    portENTER_CRITICAL(&storageMux);
+    if (pendingBuffer < 0) swapBuffersLocked();
+    toFlush = pendingBuffer;
+    portEXIT_CRITICAL(&storageMux);
+
+    if (toFlush >= 0) {
+        writeBlock(flushBuffers[toFlush], bufferFill[toFlush]);
+
+        portENTER_CRITICAL(&storageMux);
+        bufferFill[toFlush] = 0;
+        pendingBuffer = -1;
+        portEXIT_CRITICAL(&storageMux);
+    }
+
+    xSemaphoreGive(fileMutex);
+}
+
+// Zamanlayıcı veya doluluk bildirimiyle uyanıp tamponları yazan task
+static void logStorageTask(void *parameter) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LOG_FLUSH_INTERVAL));
+        flushPendingBuffer();
+    }
+}
+
+void initLogStorage() {
+    if (storageReady) return;
+
+    fileMutex = xSemaphoreCreateMutex();
+    locateWritePosition();
+    storageReady = true;
+
+    xTaskCreatePinnedToCore(
+        logStorageTask,
+        "LogStorage",
+        4096,
+        NULL,
+        tskIDLE_PRIORITY + 1,
+        &storageTaskHandle,
+        0  // Core 0
+    );
+
+    LOGI(LOG_SRC_SYSTEM, LT_LOG_STORAGE_READY, currentSegment, currentSegmentSize);
+}
+
+// Satırı aktif tampona kopyala. Hiçbir zaman flash'a yazmaz veya beklemez.
+void appendLogStorage(const char* line, size_t length) {
+    if (length + 1 > LOG_FLUSH_BLOCK_SIZE) {
+        length = LOG_FLUSH_BLOCK_SIZE - 1;
+    }
+
+    bool notify = false;
+    bool dropped = false;
+
+    portENTER_CRITICAL(&storageMux);
+    if (bufferFill[activeBuffer] + length + 1 > LOG_FLUSH_BLOCK_SIZE) {
+        // Aktif tampon dolu - diğeri boşsa yer değiştir, değilse satırı at
+        if (swapBuffersLocked()) {
+            notify = true;
+        } else {
+            dropped = true;
+        }
+    }
+
+    if (!dropped) {
+        char* dst = flushBuffers[activeBuffer] + bufferFill[activeBuffer];
+        memcpy(dst, line, length);
+        dst[length] = '\n';
+        bufferFill[activeBuffer] += length + 1;
+
+        if (bufferFill[activeBuffer] >= LOG_FLUSH_HIGH_WATER) {
+            notify = true;
+        }
+    }
+    portEXIT_CRITICAL(&storageMux);
+
+    if (dropped) {
+        droppedLines++;
+    }
+    if (notify && storageTaskHandle != NULL) {
+        xTaskNotifyGive(storageTaskHandle);
+    }
+}
+
+// Tamponlarda bekleyen her şeyi hemen yaz (örn. yeniden başlatmadan önce)
+void flushLogStorage() {
+    if (!storageReady) return;
+
+    // Bekleyen tampon ve ardından aktif tampon
+    flushPendingBuffer();
+    flushPendingBuffer();
+}
+
+LogStorageStats getLogStorageStats() {
+    LogStorageStats stats;
+
+    if (fileMutex != NULL) xSemaphoreTake(fileMutex, portMAX_DELAY);
+    stats.firstSegment = firstSegment;
+    stats.currentSegment = currentSegment;
+    stats.segmentCount = storageReady ? currentSegment - firstSegment + 1 : 0;
+    stats.currentSegmentSize = currentSegmentSize;
+    stats.bytesWritten = bytesWritten;
+    stats.flushCount = flushCount;
+    if (fileMutex != NULL) xSemaphoreGive(fileMutex);
+
+    stats.droppedLines = droppedLines;
+    return stats;
+}
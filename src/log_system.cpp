@@ -1,11 +1,93 @@
 #include "log_system.h"
+#include "log_storage.h"
+#include "log_rtc.h"
+#include <Preferences.h>
+#include <esp_heap_caps.h>
 #include <time.h>
 
+// Seri konsol kuyruğu ayarları
+#define SERIAL_LOG_QUEUE_LENGTH 32   // Kuyrukta bekleyebilecek satır sayısı
+#define SERIAL_LOG_LINE_LENGTH  192  // Satır başına sabit boyut (taşan kısım kırpılır)
+
 // log_system.h'de 'extern' olarak bildirilen global değişkenlerin
 // gerçek tanımlamaları burada yapılır.
-LogEntry logs[50];
+// Halka arabellek - PSRAM varsa oradan, yoksa dahili RAM'den ayrılır
+static LogEntry* logs = NULL;
+static uint32_t logCapacity = 0;
+static bool logsInPsram = false;
 int logIndex = 0;
 int totalLogs = 0;
+uint32_t logSequence = 0;
+uint32_t logBootId = 0;
+
+// Kaynak başına çalışma zamanı eşikleri (LogSource sırasıyla)
+uint8_t logThresholds[LOG_SOURCE_COUNT];
+
+// LogSource isimleri - enum sırasıyla aynı olmalı
+static const char* const LOG_SOURCE_NAMES[LOG_SOURCE_COUNT] = {
+    "SYSTEM", "ETH", "NET", "UART", "TIME", "NTP", "AUTH",
+    "POLICY", "WS", "WEB", "BACKUP", "RESTORE", "SETTINGS", "mDNS"
+};
+
+// Şablon metinleri - LogTemplateId sırasıyla (flash'ta kalır)
+static const char* const LOG_TEMPLATE_FORMATS[LOG_TEMPLATE_COUNT] = {
+#define LOG_TEMPLATE_FORMAT(id, format) format,
+    LOG_TEMPLATE_LIST(LOG_TEMPLATE_FORMAT)
+#undef LOG_TEMPLATE_FORMAT
+};
+
+// Halka arabelleğe farklı task'lardan yazılıp okunduğu için kilit
+static SemaphoreHandle_t logMutex = NULL;
+
+// Seri konsola gidecek satırlar - sabit boyutlu, heap kullanmaz
+struct SerialLogLine {
+    char text[SERIAL_LOG_LINE_LENGTH];
+};
+
+static QueueHandle_t serialLogQueue = NULL;
+static TaskHandle_t serialLogTaskHandle = NULL;
+static volatile uint32_t serialLogDropped = 0;
+
+// Kuyruğu boşaltan düşük öncelikli task. 115200 baud'da uzun bir satır
+// ~9 ms sürer; bu bekleme artık sadece bu task'ı durdurur.
+static void serialLogTask(void *parameter) {
+    SerialLogLine line;
+    uint32_t reportedDrops = 0;
+
+    while (true) {
+        if (xQueueReceive(serialLogQueue, &line, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            Serial.println(line.text);
+        }
+
+        // Süresi dolan tekrar özetini yaz (yeni kayıt gelmese bile)
+        flushLogRepeats(false);
+
+        // Kuyruk dolduğu için atılan satırları bildir
+        uint32_t drops = serialLogDropped;
+        if (drops != reportedDrops) {
+            Serial.printf("[LOG] %lu satır kuyruk dolu olduğu için atıldı\n",
+                          (unsigned long)(drops - reportedDrops));
+            reportedDrops = drops;
+        }
+    }
+}
+
+// Satırı kuyruğa koy, yer yoksa bekleme yapmadan at
+static void queueSerialLine(const SerialLogLine& line) {
+    if (serialLogQueue == NULL) {
+        // Task henüz başlamadıysa (çok erken loglar) doğrudan yaz
+        Serial.println(line.text);
+        return;
+    }
+
+    if (xQueueSend(serialLogQueue, &line, 0) != pdTRUE) {
+        serialLogDropped++;
+    }
+}
+
+uint32_t getSerialLogDropCount() {
+    return serialLogDropped;
+}
 
 // NTP'den geçerli zaman alınamazsa kullanılacak zaman formatı
 String getFormattedTimestampFallback() {
@@ -24,7 +106,8 @@ String getFormattedTimestampFallback() {
 // NTP'den veya sistemden zamanı alıp formatlayan ana fonksiyon
 String getFormattedTimestamp() {
     struct tm timeinfo;
-    if (getLocalTime(&timeinfo)) {
+    // Zaman ayarlı değilse bekleme (varsayılan 5 sn timeout'u kullanma)
+    if (getLocalTime(&timeinfo, 0)) {
         char buffer[32];
         strftime(buffer, sizeof(buffer), "%d.%m.%Y %H:%M:%S", &timeinfo);
         return String(buffer);
@@ -34,32 +117,349 @@ String getFormattedTimestamp() {
     }
 }
 
+// Kaydın zamanını yaz: saat ayarlıysa tarih/saat, değilse çalışma süresi
+size_t formatLogTimestamp(const LogEntry& entry, char* out, size_t size) {
+    if (size == 0) return 0;
+
+    if (entry.epoch != 0) {
+        time_t t = (time_t)entry.epoch;
+        struct tm timeinfo;
+        localtime_r(&t, &timeinfo);
+        return strftime(out, size, "%d.%m.%Y %H:%M:%S", &timeinfo);
+    }
+
+    unsigned long seconds = entry.millis_time / 1000;
+    int n = snprintf(out, size, "%02lu:%02lu:%02lu",
+                     (seconds / 3600) % 24, (seconds / 60) % 60, seconds % 60);
+    return n < 0 ? 0 : min((size_t)n, size - 1);
+}
+
+// Özet kayıtta ilk tekrarın zamanı
+size_t formatLogFirstTimestamp(const LogEntry& entry, char* out, size_t size) {
+    LogEntry first = entry;
+    first.millis_time = entry.firstMillis;
+    if (entry.epoch != 0) {
+        first.epoch = entry.epoch - (entry.millis_time - entry.firstMillis) / 1000;
+    }
+    return formatLogTimestamp(first, out, size);
+}
+
+// Şablonu paketlenmiş argümanlarla doldur. Argüman eksikse (kırpılmışsa)
+// yer tutucu "?" olarak yazılır.
+size_t formatLogMessage(const LogEntry& entry, char* out, size_t size) {
+    if (size == 0) return 0;
+
+    const char* fmt = entry.templateId < LOG_TEMPLATE_COUNT ? LOG_TEMPLATE_FORMATS[entry.templateId] : "?";
+    const uint8_t* arg = entry.args;
+    const uint8_t* argEnd = entry.args + min((size_t)entry.argLength, (size_t)LOG_ARG_BYTES);
+    size_t pos = 0;
+
+    while (*fmt && pos < size - 1) {
+        bool hex = false;
+        if (fmt[0] == '{' && fmt[1] == '}') {
+            fmt += 2;
+        } else if (fmt[0] == '{' && fmt[1] == 'x' && fmt[2] == '}') {
+            hex = true;
+            fmt += 3;
+        } else {
+            out[pos++] = *fmt++;
+            continue;
+        }
+
+        char number[16];
+        const char* text = "?";
+        size_t textLength = 1;
+        bool truncated = false;
+
+        if (arg + 1 < argEnd) {
+            uint8_t tag = *arg++;
+            if (tag == LOG_ARG_STR) {
+                uint8_t header = *arg++;
+                textLength = min((size_t)(header & ~LOG_ARG_STR_TRUNCATED), (size_t)(argEnd - arg));
+                truncated = header & LOG_ARG_STR_TRUNCATED;
+                text = (const char*)arg;
+                arg += textLength;
+            } else if (arg + 4 > argEnd) {
+                arg = argEnd;  // Bozuk/kırpılmış sayısal argüman
+            } else {
+                uint32_t raw;
+                memcpy(&raw, arg, 4);
+                arg += 4;
+                if (tag == LOG_ARG_IPV4) {
+                    snprintf(number, sizeof(number), "%lu.%lu.%lu.%lu",
+                             (unsigned long)(raw & 0xFF), (unsigned long)((raw >> 8) & 0xFF),
+                             (unsigned long)((raw >> 16) & 0xFF), (unsigned long)(raw >> 24));
+                } else if (hex) {
+                    snprintf(number, sizeof(number), "%02lX", (unsigned long)raw);
+                } else if (tag == LOG_ARG_INT) {
+                    snprintf(number, sizeof(number), "%ld", (long)(int32_t)raw);
+                } else {
+                    snprintf(number, sizeof(number), "%lu", (unsigned long)raw);
+                }
+                text = number;
+                textLength = strlen(number);
+            }
+        }
+
+        size_t n = min(textLength, size - 1 - pos);
+        memcpy(out + pos, text, n);
+        pos += n;
+        if (truncated && pos + 3 < size) {
+            memcpy(out + pos, "...", 3);
+            pos += 3;
+        }
+    }
+
+    out[pos] = '\0';
+    return pos;
+}
+
+static void packRaw(LogArgPacker& packer, uint8_t tag, uint32_t value) {
+    if (packer.length + 5 > LOG_ARG_BYTES) return;
+    packer.data[packer.length++] = tag;
+    memcpy(packer.data + packer.length, &value, 4);
+    packer.length += 4;
+}
+
+void packLogArg(LogArgPacker& packer, long value) {
+    packRaw(packer, LOG_ARG_INT, (uint32_t)value);
+}
+
+void packLogArg(LogArgPacker& packer, unsigned long value) {
+    packRaw(packer, LOG_ARG_UINT, (uint32_t)value);
+}
+
+void packLogArg(LogArgPacker& packer, const IPAddress& value) {
+    packRaw(packer, LOG_ARG_IPV4, (uint32_t)value);
+}
+
+// Metni kalan alana sığdığı kadar kopyala; UTF-8 karakterleri bölünmez
+void packLogArg(LogArgPacker& packer, const char* value) {
+    if (packer.length + 2 > LOG_ARG_BYTES) return;
+    if (value == NULL) value = "";
+
+    size_t room = LOG_ARG_BYTES - packer.length - 2;
+    size_t length = strlen(value);
+    uint8_t flags = 0;
+    if (length > room) {
+        length = room;
+        while (length > 0 && ((uint8_t)value[length] & 0xC0) == 0x80) length--;
+        flags = LOG_ARG_STR_TRUNCATED;
+    }
+
+    packer.data[packer.length++] = LOG_ARG_STR;
+    packer.data[packer.length++] = (uint8_t)length | flags;
+    memcpy(packer.data + packer.length, value, length);
+    packer.length += length;
+}
+
+// Arabellek ayır: önce PSRAM, olmazsa dahili RAM (SRAM sınırına kırpılarak).
+// O da olmazsa kapasite yarıya indirilerek tekrar denenir.
+static LogEntry* allocateLogBuffer(uint32_t& capacity, bool& inPsram) {
+    LogEntry* buffer = NULL;
+    if (psramFound()) {
+        buffer = (LogEntry*)heap_caps_calloc(capacity, sizeof(LogEntry), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    }
+    inPsram = buffer != NULL;
+    if (buffer == NULL && capacity > LOG_CAPACITY_SRAM_MAX) {
+        capacity = LOG_CAPACITY_SRAM_MAX;
+    }
+    while (buffer == NULL && capacity >= LOG_CAPACITY_MIN) {
+        buffer = (LogEntry*)heap_caps_calloc(capacity, sizeof(LogEntry), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        if (buffer == NULL) capacity /= 2;
+    }
+    if (buffer == NULL) capacity = 0;
+    return buffer;
+}
+
+static uint32_t clampLogCapacity(uint32_t capacity) {
+    if (capacity < LOG_CAPACITY_MIN) return LOG_CAPACITY_MIN;
+    if (capacity > LOG_CAPACITY_MAX) return LOG_CAPACITY_MAX;
+    return capacity;
+}
+
+// Kaydı halkaya yaz (kilit çağıran tarafından tutulur)
+static void storeLogEntry(const LogEntry& entry) {
+    if (logCapacity == 0) return;
+    logs[logIndex] = entry;
+    logIndex = (logIndex + 1) % logCapacity; // Dairesel arabellek mantığı
+    logSequence++;
+    if ((uint32_t)totalLogs < logCapacity) {
+        totalLogs++;
+    }
+}
+
 // Log sistemini başlatan fonksiyon
 void initLogSystem() {
-    for (int i = 0; i < 50; i++) {
-        logs[i].message = "";
-    }
     logIndex = 0;
     totalLogs = 0;
+    logSequence = 0;
+    logBootId = esp_random();
+
+    if (logMutex == NULL) {
+        logMutex = xSemaphoreCreateMutex();
+    }
+
+    // Kayıtlı kapasite (yoksa belleğe göre varsayılan) ile arabelleği ayır
+    Preferences prefs;
+    prefs.begin("log-config", true);
+    uint32_t capacity = prefs.getUInt("capacity",
+        psramFound() ? LOG_CAPACITY_DEFAULT_PSRAM : LOG_CAPACITY_DEFAULT_SRAM);
+    prefs.end();
+
+    if (logs == NULL) {
+        capacity = clampLogCapacity(capacity);
+        logs = allocateLogBuffer(capacity, logsInPsram);
+        logCapacity = capacity;
+    }
+
+    // Önceki çalışmanın RTC halkasındaki son kayıtlarını ana halkaya al
+    uint32_t recovered = 0;
+    uint32_t rtcCount = beginRtcLog();
+    LogEntry entry;
+    for (uint32_t i = 0; i < rtcCount; i++) {
+        if (readRtcLogEntry(i, entry)) {
+            storeLogEntry(entry);
+            recovered++;
+        }
+    }
+    resetRtcLog();
+
+    // Kaynak eşiklerini yükle (kayıt yoksa varsayılan)
+    prefs.begin("log-levels", true);
+    for (int i = 0; i < LOG_SOURCE_COUNT; i++) {
+        logThresholds[i] = prefs.getUChar(LOG_SOURCE_NAMES[i], LOG_DEFAULT_THRESHOLD);
+    }
+    prefs.end();
+
+    // Seri konsol kuyruğu ve onu boşaltan task
+    if (serialLogQueue == NULL) {
+        serialLogQueue = xQueueCreate(SERIAL_LOG_QUEUE_LENGTH, sizeof(SerialLogLine));
+        xTaskCreatePinnedToCore(
+            serialLogTask,
+            "SerialLog",
+            3072,
+            NULL,
+            tskIDLE_PRIORITY + 1,
+            &serialLogTaskHandle,
+            0  // Core 0
+        );
+    }
+
+    if (recovered > 0) {
+        LOGW(LOG_SRC_SYSTEM, LT_LOG_RECOVERED, recovered, resetReasonToString());
+    }
+
     // Sistem başlatıldığında ilk logu ekle
-    addLog("Log sistemi başlatıldı.", INFO, "SYSTEM");
+    LOGI(LOG_SRC_SYSTEM, LT_LOG_STARTED);
 }
 
-// Yeni bir log ekleyen ana fonksiyon
-void addLog(const String& msg, LogLevel level, const String& source) {
-    logs[logIndex].timestamp = getFormattedTimestamp();
-    logs[logIndex].message = msg;
-    logs[logIndex].level = level;
-    logs[logIndex].source = source;
-    logs[logIndex].millis_time = millis();
+// Kaydı seri konsola ve kalıcı depoya yaz
+static void emitLogLine(const LogEntry& entry) {
+    // Seri monitöre de logu bas - kuyruk üzerinden, çağıranı bekletmeden
+    SerialLogLine line;
+    char timestamp[24];
+    formatLogTimestamp(entry, timestamp, sizeof(timestamp));
+    int n = snprintf(line.text, sizeof(line.text), "[%s] [%s] [%s] ",
+                     timestamp, logLevelToString((LogLevel)entry.level).c_str(), LOG_SOURCE_NAMES[entry.source]);
+    if (n > 0 && n < (int)sizeof(line.text)) {
+        n += formatLogMessage(entry, line.text + n, sizeof(line.text) - n);
+    }
+    if (entry.repeatCount > 0 && n > 0 && n < (int)sizeof(line.text)) {
+        formatLogFirstTimestamp(entry, timestamp, sizeof(timestamp));
+        snprintf(line.text + n, sizeof(line.text) - n, " [x%u, ilk: %s]", entry.repeatCount, timestamp);
+    }
+    queueSerialLine(line);
 
-    logIndex = (logIndex + 1) % 50; // Dairesel arabellek mantığı
-    if (totalLogs < 50) {
-        totalLogs++;
+    // Kalıcı depoya da ekle (DEBUG satırları flash'ı yıpratmasın diye hariç)
+    if (entry.level != DEBUG) {
+        appendLogStorage(line.text, strlen(line.text));
+    }
+}
+
+// Tekrar bastırma durumu (logMutex ile korunur). lastLogged: halkaya en son
+// yazılan kayıt; pendingRepeat: ondan sonra gelen ve henüz yazılmamış tekrarlar.
+static LogEntry lastLogged;
+static bool hasLastLogged = false;
+static LogEntry pendingRepeat;
+
+static bool isSameLogPattern(const LogEntry& entry) {
+    return hasLastLogged && entry.templateId == lastLogged.templateId &&
+           entry.level == lastLogged.level && entry.source == lastLogged.source;
+}
+
+// Bekleyen tekrarları özet kayıt olarak halkaya yaz (kilit tutulurken)
+static bool takePendingRepeat(LogEntry& summary) {
+    if (pendingRepeat.repeatCount == 0) return false;
+    summary = pendingRepeat;
+    pendingRepeat.repeatCount = 0;
+    storeLogEntry(summary);
+    appendRtcLog(summary);
+    lastLogged = summary;
+    return true;
+}
+
+// Pencere süresi dolan (force ile: her) bekleyen özeti yaz
+void flushLogRepeats(bool force) {
+    LogEntry summary;
+    bool flushed = false;
+
+    if (logMutex != NULL) xSemaphoreTake(logMutex, portMAX_DELAY);
+    if (pendingRepeat.repeatCount > 0 &&
+        (force || (uint32_t)millis() - pendingRepeat.firstMillis >= LOG_REPEAT_WINDOW)) {
+        flushed = takePendingRepeat(summary);
+    }
+    if (logMutex != NULL) xSemaphoreGive(logMutex);
+
+    if (flushed) emitLogLine(summary);
+}
+
+// Yeni bir log ekleyen ana fonksiyon (LOGx makroları logEvent üzerinden çağırır)
+void commitLogEvent(LogLevel level, LogSource source, LogTemplateId tpl, const LogArgPacker& args) {
+    LogEntry entry;
+    time_t now = time(nullptr);
+    entry.millis_time = millis();
+    entry.epoch = now > 1600000000 ? (uint32_t)now : 0;  // 2020 öncesi = saat ayarlanmamış
+    entry.firstMillis = entry.millis_time;
+    entry.repeatCount = 0;
+    entry.templateId = tpl;
+    entry.level = level;
+    entry.source = source;
+    entry.argLength = args.length;
+    memcpy(entry.args, args.data, args.length);
+
+    LogEntry summary;
+    bool flushed = false;
+
+    bool repeat = false;
+
+    if (logMutex != NULL) xSemaphoreTake(logMutex, portMAX_DELAY);
+    if (isSameLogPattern(entry)) {
+        // Süren döngüde pencere dolduysa özeti yaz, yeni pencere başlat
+        if (pendingRepeat.repeatCount > 0 && entry.millis_time - pendingRepeat.firstMillis >= LOG_REPEAT_WINDOW) {
+            flushed = takePendingRepeat(summary);
+        }
+        repeat = pendingRepeat.repeatCount > 0 || entry.millis_time - lastLogged.millis_time < LOG_REPEAT_WINDOW;
+    }
+
+    if (repeat) {
+        // Tekrar: sadece sayacı ve son argümanları güncelle, yazma
+        uint16_t count = pendingRepeat.repeatCount;
+        uint32_t first = count > 0 ? pendingRepeat.firstMillis : entry.millis_time;
+        pendingRepeat = entry;
+        pendingRepeat.firstMillis = first;
+        pendingRepeat.repeatCount = count < 0xFFFF ? count + 1 : count;
+    } else {
+        flushed = takePendingRepeat(summary);  // Desen değişti: önce özeti yaz
+        storeLogEntry(entry);
+        appendRtcLog(entry);  // Reset sonrası kurtarılabilsin
+        lastLogged = entry;
+        hasLastLogged = true;
     }
+    if (logMutex != NULL) xSemaphoreGive(logMutex);
 
-    // Seri monitöre de logu bas
-    Serial.println("[" + getFormattedTimestamp() + "] [" + logLevelToString(level) + "] [" + source + "] " + msg);
+    if (flushed) emitLogLine(summary);
+    if (!repeat) emitLogLine(entry);
 }
 
 // Log seviyesini string'e çeviren yardımcı fonksiyon
@@ -74,12 +474,108 @@ String logLevelToString(LogLevel level) {
     }
 }
 
+// İsimden log seviyesine çevir, bilinmiyorsa -1
+int logLevelFromString(const String& name) {
+    if (name == "ERROR")   return ERROR;
+    if (name == "WARN")    return WARN;
+    if (name == "INFO")    return INFO;
+    if (name == "DEBUG")   return DEBUG;
+    if (name == "SUCCESS") return SUCCESS;
+    return -1;
+}
+
+const char* logSourceToString(LogSource source) {
+    return source < LOG_SOURCE_COUNT ? LOG_SOURCE_NAMES[source] : "UNKNOWN";
+}
+
+// İsimden log kaynağına çevir, bilinmiyorsa -1
+int logSourceFromString(const String& name) {
+    for (int i = 0; i < LOG_SOURCE_COUNT; i++) {
+        if (name.equalsIgnoreCase(LOG_SOURCE_NAMES[i])) return i;
+    }
+    return -1;
+}
+
+// Kaynağın çalışma zamanı eşiğini değiştir ve kalıcı olarak kaydet.
+// Derleme zamanında çıkarılmış seviyeler burada tekrar açılamaz.
+bool setLogThreshold(LogSource source, uint8_t rank) {
+    if (source >= LOG_SOURCE_COUNT || rank > LOG_RANK_DEBUG) return false;
+
+    logThresholds[source] = rank;
+
+    Preferences prefs;
+    prefs.begin("log-levels", false);
+    prefs.putUChar(LOG_SOURCE_NAMES[source], rank);
+    prefs.end();
+    return true;
+}
+
+// Halkadaki en eski kaydın id'si
+uint32_t getOldestLogId() {
+    return logSequence - totalLogs;
+}
+
+// id'si verilen kaydın kopyasını al. Kayıt hiç yazılmadıysa veya
+// üzerine yazıldıysa false döner. Kilit sadece kopyalama süresince tutulur.
+bool getLogEntry(uint32_t id, LogEntry& out) {
+    bool found = false;
+
+    if (logMutex != NULL) xSemaphoreTake(logMutex, portMAX_DELAY);
+    if (id < logSequence && logSequence - id <= (uint32_t)totalLogs) {
+        out = logs[id % logCapacity];
+        found = true;
+    }
+    if (logMutex != NULL) xSemaphoreGive(logMutex);
+
+    return found;
+}
+
+uint32_t getLogCapacity() {
+    return logCapacity;
+}
+
+bool isLogBufferInPsram() {
+    return logsInPsram;
+}
+
+// Kapasiteyi değiştir: yeni arabellek ayrılır, mevcut kayıtlar (sığdığı kadar,
+// en yeniler) id'leri korunarak taşınır. Değer kalıcı olarak kaydedilir.
+bool setLogCapacity(uint32_t capacity) {
+    if (capacity < LOG_CAPACITY_MIN || capacity > LOG_CAPACITY_MAX) return false;
+
+    bool inPsram = false;
+    LogEntry* buffer = allocateLogBuffer(capacity, inPsram);
+    if (buffer == NULL) return false;
+
+    if (logMutex != NULL) xSemaphoreTake(logMutex, portMAX_DELAY);
+    uint32_t keep = min((uint32_t)totalLogs, capacity);
+    for (uint32_t id = logSequence - keep; id != logSequence; id++) {
+        buffer[id % capacity] = logs[id % logCapacity];
+    }
+    LogEntry* old = logs;
+    logs = buffer;
+    logCapacity = capacity;
+    logsInPsram = inPsram;
+    totalLogs = keep;
+    logIndex = logSequence % capacity;
+    if (logMutex != NULL) xSemaphoreGive(logMutex);
+
+    heap_caps_free(old);
+
+    Preferences prefs;
+    prefs.begin("log-config", false);
+    prefs.putUInt("capacity", capacity);
+    prefs.end();
+    return true;
+}
+
 // Tüm logları temizleyen fonksiyon
 void clearLogs() {
-    for (int i = 0; i < 50; i++) {
-        logs[i].message = "";
-    }
-    logIndex = 0;
+    if (logMutex != NULL) xSemaphoreTake(logMutex, portMAX_DELAY);
+    // logIndex sıfırlanmaz: id -> yuva eşlemesi (id % kapasite) korunur
     totalLogs = 0;
-    addLog("Log kayıtları temizlendi.", WARN, "SYSTEM");
+    hasLastLogged = false;
+    pendingRepeat.repeatCount = 0;
+    if (logMutex != NULL) xSemaphoreGive(logMutex);
+    LOGW(LOG_SRC_SYSTEM, LT_LOG_CLEARED);
 }
\ No newline at end of file
@@ -4,48 +4,44 @@
 #include <esp_log.h>
 #include "settings.h"
 #include "log_system.h"
+#include "log_storage.h"
 #include "uart_handler.h"
+#include "uart_jobs.h"
 #include "web_routes.h"
 #include "websocket_handler.h"   // Yeni eklenen
+#include "status_snapshot.h"
 #include "password_policy.h"     // Yeni eklenen
 #include "backup_restore.h"      // Yeni eklenen
+#include "auth_system.h"
 // HTTPS desteği şimdilik devre dışı (kütüphane uyumsuzluğu)
 
 // External fonksiyonlar - time_sync.cpp
 extern void checkTimeSync();
-extern String getTimeSyncStats();
+extern void logTimeSyncStats();
 
 // External fonksiyonlar - network_config.cpp  
 extern void loadNetworkConfig();
 extern void initEthernetAdvanced();
 
 // Task handle'ları
-TaskHandle_t webTaskHandle = NULL;
 TaskHandle_t uartTaskHandle = NULL;
 
 // Sistem değişkenleri
 unsigned long lastHeapCheck = 0;
 size_t minFreeHeap = SIZE_MAX;
 
-// Web server task - Core 0'da çalışacak
-void webServerTask(void *parameter) {
-    while(true) {
-        server.handleClient();
-        // mDNS.update() ESP32'de gerekli değil
-        vTaskDelay(1);
-    }
-}
-
 // UART ve zaman senkronizasyon task - Core 1'de
+// UART'a sadece bu task dokunur; web istekleri işlerini kuyruğa atar.
 void uartTask(void *parameter) {
     while(true) {
+        // Web/WebSocket'ten gelen UART işleri (en fazla 1 saniye bekler)
+        runUartJobs(pdMS_TO_TICKS(1000));
+        
         // Zaman senkronizasyonu kontrolü (5 dakikada bir)
         checkTimeSync();
         
         // UART sağlık kontrolü
         checkUARTHealth();
-        
-        vTaskDelay(1000); // 1 saniye
     }
 }
 
@@ -58,7 +54,7 @@ void initMDNS() {
     sprintf(hostname, "teias-%02x%02x", mac[4], mac[5]);
     
     if (MDNS.begin(hostname)) {
-        addLog("✅ mDNS başlatıldı: " + String(hostname) + ".local", SUCCESS, "mDNS");
+        LOGS(LOG_SRC_MDNS, LT_MDNS_STARTED, hostname);
         
         // HTTP servisini duyur
         MDNS.addService("http", "tcp", 80);
@@ -84,7 +80,7 @@ void initMDNS() {
         Serial.println("╚════════════════════════════════════════╝\n");
         
     } else {
-        addLog("❌ mDNS başlatılamadı", ERROR, "mDNS");
+        LOGE(LOG_SRC_MDNS, LT_MDNS_FAILED);
     }
 }
 
@@ -120,6 +116,10 @@ void setup() {
     initLogSystem();
     Serial.println("✅");
     
+    Serial.print("► Kalıcı Log Deposu... ");
+    initLogStorage();
+    Serial.println("✅");
+    
     Serial.print("► Ayarlar... ");
     loadSettings();
     Serial.println("✅");
@@ -134,6 +134,7 @@ void setup() {
     
     Serial.print("► UART (TX2:IO17, RX2:IO5)... ");
     initUART();
+    initUartJobs();
     Serial.println("✅");
     
     Serial.print("► Web Sunucu... ");
@@ -144,6 +145,10 @@ void setup() {
     initWebSocket();
     Serial.println("✅");
     
+    Serial.print("► Durum Görüntüsü... ");
+    initStatusSnapshot();
+    Serial.println("✅");
+    
     Serial.print("► Parola Politikası... ");
     loadPasswordPolicy();
     Serial.println("✅");
@@ -151,17 +156,7 @@ void setup() {
     Serial.print("► mDNS... ");
     initMDNS();
     
-    // Multi-core task'ları başlat
-    xTaskCreatePinnedToCore(
-        webServerTask,
-        "WebServer",
-        8192,
-        NULL,
-        2,
-        &webTaskHandle,
-        0  // Core 0
-    );
-    
+    // Web sunucu kendi async_tcp task'ında çalışır, ayrı task gerekmez
     xTaskCreatePinnedToCore(
         uartTask,
         "UART",
@@ -186,8 +181,8 @@ void setup() {
     Serial.println("║");
     Serial.println("╚════════════════════════════════════════╝\n");
     
-    addLog("🚀 Sistem başlatıldı", SUCCESS, "SYSTEM");
-    addLog("📍 Trafo Merkezi: " + settings.transformerStation, INFO, "SYSTEM");
+    LOGS(LOG_SRC_SYSTEM, LT_SYSTEM_STARTED);
+    LOGI(LOG_SRC_SYSTEM, LT_SYSTEM_STATION, settings.transformerStation);
 }
 
 void checkSystemHealth() {
@@ -198,10 +193,12 @@ void checkSystemHealth() {
     }
     
     if (currentHeap < 10000) {
-        addLog("⚠️ Düşük bellek: " + String(currentHeap), WARN, "SYSTEM");
+        LOGW(LOG_SRC_SYSTEM, LT_SYSTEM_LOW_HEAP, currentHeap);
     }
     
     if (currentHeap < 5000) {
+        LOGE(LOG_SRC_SYSTEM, LT_SYSTEM_CRITICAL_HEAP, currentHeap);
+        flushLogStorage();  // Son kayıtlar kaybolmasın
         ESP.restart();
     }
 }
@@ -212,6 +209,9 @@ void loop() {
     // WebSocket handling
     handleWebSocket();
     
+    // Backup geri yükleme sonrası planlanmış restart
+    checkPendingRestart();
+    
     // Automatic backup - her 24 saatte bir
     static unsigned long lastBackupCheck = 0;
     if (now - lastBackupCheck > 3600000) { // Her saat kontrol et
@@ -234,37 +234,32 @@ void loop() {
         
         if (currentEthStatus != lastEthStatus) {
             if (currentEthStatus) {
-                addLog("✅ Ethernet bağlandı", SUCCESS, "ETH");
+                LOGS(LOG_SRC_ETH, LT_ETH_CONNECTED);
                 
                 // Bağlantı bilgilerini logla
-                addLog("IP: " + ETH.localIP().toString(), INFO, "ETH");
-                addLog("Hız: " + String(ETH.linkSpeed()) + " Mbps", INFO, "ETH");
+                LOGI(LOG_SRC_ETH, LT_ETH_IP, ETH.localIP());
+                LOGI(LOG_SRC_ETH, LT_ETH_SPEED, ETH.linkSpeed());
             } else {
-                addLog("❌ Ethernet kesildi", ERROR, "ETH");
+                LOGE(LOG_SRC_ETH, LT_ETH_DISCONNECTED);
             }
             lastEthStatus = currentEthStatus;
         }
         lastEthCheck = now;
     }
     
-    // Session timeout kontrolü
-    if (settings.isLoggedIn) {
-        if (millis() - settings.sessionStartTime > settings.SESSION_TIMEOUT) {
-            settings.isLoggedIn = false;
-            addLog("Oturum zaman aşımı", INFO, "AUTH");
-        }
-    }
+    // Session timeout kontrolü - her oturumun kendi süresi var
+    expireSessions();
     
     // Zaman senkronizasyon durumunu logla - 1 saatte bir
     static unsigned long lastTimeSyncLog = 0;
     if (now - lastTimeSyncLog > 3600000) { // 1 saat
-        addLog(getTimeSyncStats(), INFO, "TIME");
+        logTimeSyncStats();
         lastTimeSyncLog = now;
     }
     
     // İlk giriş sonrası parola değiştirme kontrolü
     static bool passwordChangeChecked = false;
-    if (settings.isLoggedIn && !passwordChangeChecked) {
+    if (getActiveSessionCount() > 0 && !passwordChangeChecked) {
         if (mustChangePassword()) {
             // WebSocket üzerinden bildirim gönder
             broadcastLog("Parolanızı değiştirmeniz gerekmektedir", "WARNING", "AUTH");
@@ -272,14 +267,14 @@ void loop() {
         passwordChangeChecked = true;
     }
     
-    // WebSocket broadcast - her 5 saniyede bir durum güncellemesi
+    // WebSocket broadcast - her görüntü yenilemesinde (clientlara sadece değişen alanlar gider)
     static unsigned long lastBroadcast = 0;
-    if (now - lastBroadcast > 5000) {
+    if (now - lastBroadcast >= STATUS_SNAPSHOT_INTERVAL) {
         if (isWebSocketConnected()) {
             broadcastStatus();
         }
         lastBroadcast = now;
     }
     
-    vTaskDelay(100); // 100ms
+    vTaskDelay(10); // 10ms - iş sonuçları WebSocket'e gecikmeden gitsin
 }
\ No newline at end of file
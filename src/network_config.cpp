@@ -11,12 +11,12 @@ extern Settings settings;
 void loadNetworkConfig() {
     // Settings zaten loadSettings() içinde yükleniyor
     // Bu fonksiyon sadece uyumluluk için
-    addLog("Network yapılandırması hazır", INFO, "NET");
+    LOGI(LOG_SRC_NET, LT_NET_CONFIG_READY);
 }
 
 // Ethernet başlatma - Gelişmiş versiyon
 void initEthernetAdvanced() {
-    addLog("Ethernet başlatılıyor...", INFO, "ETH");
+    LOGI(LOG_SRC_ETH, LT_ETH_STARTING);
     
     // WT32-ETH01 için doğru pinler
     ETH.begin(1, 16, 23, 18, ETH_PHY_LAN8720, ETH_CLOCK_GPIO17_OUT);
@@ -26,12 +26,12 @@ void initEthernetAdvanced() {
     if (settings.local_IP != IPAddress(0,0,0,0)) {
         // Statik IP ayarla
         if (!ETH.config(settings.local_IP, settings.gateway, settings.subnet, settings.primaryDNS)) {
-            addLog("❌ Statik IP atanamadı!", ERROR, "ETH");
+            LOGE(LOG_SRC_ETH, LT_ETH_STATIC_IP_FAILED);
         } else {
-            addLog("✅ Statik IP: " + settings.local_IP.toString(), SUCCESS, "ETH");
+            LOGS(LOG_SRC_ETH, LT_ETH_STATIC_IP, settings.local_IP);
         }
     } else {
-        addLog("DHCP ile IP alınıyor...", INFO, "ETH");
+        LOGI(LOG_SRC_ETH, LT_ETH_DHCP);
     }
     
     // Bağlantı bekleme
@@ -42,16 +42,16 @@ void initEthernetAdvanced() {
     
     if (ETH.linkUp()) {
         // IP bilgilerini göster
-        addLog("✅ Ethernet aktif", SUCCESS, "ETH");
-        addLog("IP Adresi: " + ETH.localIP().toString(), INFO, "ETH");
-        addLog("Gateway: " + ETH.gatewayIP().toString(), INFO, "ETH");
-        addLog("Subnet: " + ETH.subnetMask().toString(), INFO, "ETH");
-        addLog("DNS: " + ETH.dnsIP().toString(), INFO, "ETH");
-        addLog("MAC: " + ETH.macAddress(), INFO, "ETH");
+        LOGS(LOG_SRC_ETH, LT_ETH_ACTIVE);
+        LOGI(LOG_SRC_ETH, LT_ETH_IP, ETH.localIP());
+        LOGI(LOG_SRC_ETH, LT_ETH_GATEWAY, ETH.gatewayIP());
+        LOGI(LOG_SRC_ETH, LT_ETH_SUBNET, ETH.subnetMask());
+        LOGI(LOG_SRC_ETH, LT_ETH_DNS, ETH.dnsIP());
+        LOGI(LOG_SRC_ETH, LT_ETH_MAC, ETH.macAddress());
         
         // Hız ve duplex bilgisi
-        addLog("Link Hızı: " + String(ETH.linkSpeed()) + " Mbps", INFO, "ETH");
-        addLog("Duplex: " + String(ETH.fullDuplex() ? "Full" : "Half"), INFO, "ETH");
+        LOGI(LOG_SRC_ETH, LT_ETH_SPEED, ETH.linkSpeed());
+        LOGI(LOG_SRC_ETH, LT_ETH_DUPLEX, ETH.fullDuplex() ? "Full" : "Half");
         
         // IP'yi settings'e kaydet (DHCP'den alındıysa)
         if (settings.local_IP == IPAddress(0,0,0,0)) {
@@ -61,6 +61,6 @@ void initEthernetAdvanced() {
             settings.primaryDNS = ETH.dnsIP();
         }
     } else {
-        addLog("⚠️ Ethernet kablosu bağlı değil", WARN, "ETH");
+        LOGW(LOG_SRC_ETH, LT_ETH_NO_CABLE);
     }
 }
\ No newline at end of file
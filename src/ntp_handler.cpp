@@ -2,6 +2,7 @@
 #include "ntp_handler.h"
 #include "log_system.h"
 #include "uart_handler.h"
+#include "settings.h"
 #include <Preferences.h>
 
 // Global değişkenler
@@ -14,7 +15,7 @@ bool requestNTPFromBackend() {
     
     // getNTP komutu gönder
     if (!sendCustomCommand("getNTP", response, 3000)) {
-        addLog("❌ dsPIC33EP'den NTP bilgisi alınamadı", ERROR, "NTP");
+        LOGE(LOG_SRC_NTP, LT_NTP_REQUEST_FAILED);
         return false;
     }
     
@@ -35,20 +36,20 @@ bool requestNTPFromBackend() {
             server1.toCharArray(ntpConfig.ntpServer1, sizeof(ntpConfig.ntpServer1));
             server2.toCharArray(ntpConfig.ntpServer2, sizeof(ntpConfig.ntpServer2));
             
-            addLog("✅ NTP sunucuları dsPIC33EP'den alındı: " + server1 + ", " + server2, SUCCESS, "NTP");
+            LOGS(LOG_SRC_NTP, LT_NTP_RECEIVED, server1, server2);
             return true;
         }
     }
     
-    addLog("❌ Geçersiz NTP yanıt formatı: " + response, ERROR, "NTP");
+    LOGE(LOG_SRC_NTP, LT_NTP_BAD_RESPONSE, response);
     return false;
 }
 
 // NTP ayarlarını dsPIC33EP'ye gönder
-void sendNTPConfigToBackend() {
+bool sendNTPConfigToBackend() {
     if (strlen(ntpConfig.ntpServer1) == 0) {
-        addLog("NTP sunucu adresi boş", WARN, "NTP");
-        return;
+        LOGW(LOG_SRC_NTP, LT_NTP_SERVER_EMPTY);
+        return false;
     }
     
     // Yeni format: "setNTP:server1,server2"
@@ -57,13 +58,15 @@ void sendNTPConfigToBackend() {
     
     if (sendCustomCommand(command, response, 2000)) {
         if (response == "ACK" || response.indexOf("OK") >= 0) {
-            addLog("✅ NTP ayarları dsPIC33EP tarafından onaylandı", SUCCESS, "NTP");
+            LOGS(LOG_SRC_NTP, LT_NTP_ACKED);
         } else {
-            addLog("dsPIC33EP yanıtı: " + response, WARN, "NTP");
+            LOGW(LOG_SRC_NTP, LT_DSPIC_RESPONSE, response);
         }
-    } else {
-        addLog("⚠️ NTP ayarları için yanıt alınamadı", WARN, "NTP");
+        return true;
     }
+    
+    LOGW(LOG_SRC_NTP, LT_NTP_NO_RESPONSE);
+    return false;
 }
 
 bool loadNTPSettings() {
@@ -98,7 +101,7 @@ bool loadNTPSettings() {
     preferences.end();
     
     ntpConfigured = true;
-    addLog("✅ NTP ayarları yüklendi", SUCCESS, "NTP");
+    LOGS(LOG_SRC_NTP, LT_NTP_LOADED);
     return true;
 }
 
@@ -121,12 +124,12 @@ bool isValidIPOrDomain(const String& address) {
 
 bool saveNTPSettings(const String& server1, const String& server2, int timezone) {
     if (!isValidIPOrDomain(server1)) {
-        addLog("Geçersiz birincil NTP sunucu", ERROR, "NTP");
+        LOGE(LOG_SRC_NTP, LT_NTP_INVALID_PRIMARY);
         return false;
     }
     
     if (server2.length() > 0 && !isValidIPOrDomain(server2)) {
-        addLog("Geçersiz ikincil NTP sunucu", ERROR, "NTP");
+        LOGE(LOG_SRC_NTP, LT_NTP_INVALID_SECONDARY);
         return false;
     }
     
@@ -146,11 +149,11 @@ bool saveNTPSettings(const String& server1, const String& server2, int timezone)
     ntpConfig.timezone = timezone;
     ntpConfig.enabled = true;
     ntpConfigured = true;
+    bumpConfigVersion();
     
-    addLog("✅ NTP ayarları kaydedildi", SUCCESS, "NTP");
+    LOGS(LOG_SRC_NTP, LT_NTP_SAVED);
     
-    // dsPIC33EP'ye gönder
-    sendNTPConfigToBackend();
+    // dsPIC33EP'ye gönderim çağıranın işi (web tarafında UART iş kuyruğu)
     return true;
 }
 
@@ -158,7 +161,7 @@ bool saveNTPSettings(const String& server1, const String& server2, int timezone)
 void initNTPHandler() {
     // NTP ayarları yükleme
     if (!loadNTPSettings()) {
-        addLog("⚠️ Kayıtlı NTP ayarı bulunamadı, varsayılanlar kullanılıyor", WARN, "NTP");
+        LOGW(LOG_SRC_NTP, LT_NTP_DEFAULTS);
         // Varsayılan ayarları yükle
         strcpy(ntpConfig.ntpServer1, "pool.ntp.org");
         strcpy(ntpConfig.ntpServer2, "time.google.com");
@@ -171,7 +174,7 @@ void initNTPHandler() {
     delay(1000); // Backend'in hazır olmasını bekle
     sendNTPConfigToBackend();
     
-    addLog("✅ NTP Handler başlatıldı", SUCCESS, "NTP");
+    LOGS(LOG_SRC_NTP, LT_NTP_STARTED);
 }
 
 // Eski fonksiyonları inline yap (çoklu tanımlama hatası için)
@@ -208,5 +211,5 @@ void resetNTPSettings() {
     
     ntpConfigured = false;
     
-    addLog("NTP ayarları sıfırlandı", INFO, "NTP");
+    LOGI(LOG_SRC_NTP, LT_NTP_RESET);
 }
\ No newline at end of file
@@ -4,9 +4,10 @@
 #include "log_system.h"
 #include "crypto_utils.h"
 #include "auth_system.h"  // checkSession için
-#include <WebServer.h>
+#include "chunked_response.h"
+#include "web_asset_names.h"     // Derleme öncesi üretilir (scripts/build_web_assets.py)
+#include <ESPAsyncWebServer.h>
 
-extern WebServer server;
 extern Settings settings;
 
 // Global password policy değişkeni (header'da extern olarak tanımlı)
@@ -37,7 +38,7 @@ void loadPasswordPolicy() {
     
     prefs.end();
     
-    addLog("Parola politikası yüklendi", INFO, "POLICY");
+    LOGI(LOG_SRC_POLICY, LT_POLICY_LOADED);
 }
 
 // Parola politikasını kaydet
@@ -169,10 +170,9 @@ bool mustChangePassword() {
 }
 
 // Web handler - Parola değiştirme sayfası
-void handlePasswordChangePage() {
-    if (!checkSession()) {
-        server.sendHeader("Location", "/login");
-        server.send(302);
+void handlePasswordChangePage(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->redirect("/login");
         return;
     }
     
@@ -183,7 +183,7 @@ void handlePasswordChangePage() {
     <meta charset="UTF-8">
     <meta name="viewport" content="width=device-width, initial-scale=1.0">
     <title>Parola Değiştir - TEİAŞ EKLİM</title>
-    <link rel="stylesheet" href="/style.css">
+    <link rel="stylesheet" href=")" WEB_ASSET_STYLE_CSS R"(">
     <style>
         .password-change-container {
             max-width: 500px;
@@ -355,43 +355,43 @@ void handlePasswordChangePage() {
 </html>
     )";
     
-    server.send(200, "text/html", html);
+    request->send(200, "text/html", html);
 }
 
 // API handler - Parola değiştirme
-void handlePasswordChangeAPI() {
-    if (!checkSession()) {
-        server.send(401, "application/json", "{\"error\":\"Unauthorized\"}");
+void handlePasswordChangeAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        sendJsonError(request, 401, "Unauthorized");
         return;
     }
     
-    String currentPassword = server.arg("currentPassword");
-    String newPassword = server.arg("newPassword");
-    String confirmPassword = server.arg("confirmPassword");
+    String currentPassword = request->arg("currentPassword");
+    String newPassword = request->arg("newPassword");
+    String confirmPassword = request->arg("confirmPassword");
     
     // Mevcut parola kontrolü
     String hashedCurrent = sha256(currentPassword, settings.passwordSalt);
     if (hashedCurrent != settings.passwordHash) {
-        server.send(400, "application/json", "{\"error\":\"Mevcut parola yanlış\"}");
-        addLog("❌ Parola değiştirme başarısız: Yanlış mevcut parola", ERROR, "AUTH");
+        sendJsonError(request, 400, "Mevcut parola yanlış");
+        LOGE(LOG_SRC_AUTH, LT_AUTH_PASSWORD_WRONG);
         return;
     }
     
     // Yeni parolaların eşleşme kontrolü
     if (newPassword != confirmPassword) {
-        server.send(400, "application/json", "{\"error\":\"Yeni parolalar eşleşmiyor\"}");
+        sendJsonError(request, 400, "Yeni parolalar eşleşmiyor");
         return;
     }
     
     // Parola karmaşıklık kontrolü
     if (!isPasswordComplex(newPassword)) {
-        server.send(400, "application/json", "{\"error\":\"Parola gereksinimleri karşılanmıyor\"}");
+        sendJsonError(request, 400, "Parola gereksinimleri karşılanmıyor");
         return;
     }
     
     // Parola geçmişi kontrolü
     if (isPasswordInHistory(newPassword)) {
-        server.send(400, "application/json", "{\"error\":\"Bu parola daha önce kullanılmış\"}");
+        sendJsonError(request, 400, "Bu parola daha önce kullanılmış");
         return;
     }
     
@@ -418,10 +418,10 @@ void handlePasswordChangeAPI() {
     passwordPolicy.lastPasswordChange = millis();
     savePasswordPolicy();
     
-    addLog("✅ Parola başarıyla değiştirildi", SUCCESS, "AUTH");
+    LOGS(LOG_SRC_AUTH, LT_AUTH_PASSWORD_CHANGED);
     
-    server.send(200, "application/json", "{\"success\":true,\"message\":\"Parola değiştirildi\"}");
+    sendJsonResult(request, 200, true, "Parola değiştirildi");
     
-    // Oturumu sonlandır
-    settings.isLoggedIn = false;
+    // Oturumları sonlandır
+    endAllSessions();
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#include "rate_limiter.h"
+
+// Token'lar mikro-token olarak tutulur (1000000 = bir istek); sık gelen
+// isteklerde dolum artığı yuvarlamada kaybolmaz
+#define RATE_TOKEN_UNIT  1000000UL
+
+static const RateBudget RATE_BUDGETS[RATE_CLASS_COUNT] = {
+    {40, 50},      // RATE_STATIC: 40'lık patlama, saniyede 20
+    {20, 200},     // RATE_API: 20'lik patlama, saniyede 5
+    {4, 2000},     // RATE_UART: 4'lük patlama, 2 saniyede 1
+};
+
+struct RateClient {
+    uint32_t ip;                            // 0: boş slot
+    unsigned long updated;                  // Son dolum zamanı (ms)
+    uint32_t tokens[RATE_CLASS_COUNT];
+    uint8_t loginFailures;
+    bool loginLocked;
+    unsigned long lockedAt;
+};
+
+static RateClient clients[RATE_LIMIT_CLIENTS];
+
+// IP'nin kaydı; yoksa boş ya da en uzun süredir görülmeyen slot yeni istemciye verilir
+static RateClient& findRateClient(uint32_t ip, unsigned long now) {
+    int victim = 0;
+    for (int i = 0; i < RATE_LIMIT_CLIENTS; i++) {
+        if (clients[i].ip == ip) return clients[i];
+        if (clients[victim].ip != 0 &&
+            (clients[i].ip == 0 || now - clients[i].updated > now - clients[victim].updated)) {
+            victim = i;
+        }
+    }
+    
+    RateClient& client = clients[victim];
+    client.ip = ip;
+    client.updated = now;
+    for (int c = 0; c < RATE_CLASS_COUNT; c++) {
+        client.tokens[c] = RATE_BUDGETS[c].burst * RATE_TOKEN_UNIT;
+    }
+    client.loginFailures = 0;
+    client.loginLocked = false;
+    return client;
+}
+
+static void refill(RateClient& client, unsigned long now) {
+    unsigned long elapsed = now - client.updated;
+    if (elapsed == 0) return;
+    client.updated = now;
+    
+    for (int c = 0; c < RATE_CLASS_COUNT; c++) {
+        uint32_t capacity = RATE_BUDGETS[c].burst * RATE_TOKEN_UNIT;
+        uint64_t gained = (uint64_t)elapsed * RATE_TOKEN_UNIT / RATE_BUDGETS[c].refillMs;
+        uint64_t tokens = client.tokens[c] + gained;
+        client.tokens[c] = tokens > capacity ? capacity : (uint32_t)tokens;
+    }
+}
+
+bool takeRateToken(uint32_t ip, RateClass rateClass, uint32_t& retryAfter) {
+    unsigned long now = millis();
+    RateClient& client = findRateClient(ip, now);
+    refill(client, now);
+    
+    if (client.tokens[rateClass] >= RATE_TOKEN_UNIT) {
+        client.tokens[rateClass] -= RATE_TOKEN_UNIT;
+        return true;
+    }
+    
+    // Bir token dolana kadar geçecek süre, yukarı yuvarlanmış saniye
+    uint32_t missing = RATE_TOKEN_UNIT - client.tokens[rateClass];
+    uint32_t waitMs = (uint64_t)missing * RATE_BUDGETS[rateClass].refillMs / RATE_TOKEN_UNIT;
+    retryAfter = (waitMs + 999) / 1000;
+    if (retryAfter == 0) retryAfter = 1;
+    return false;
+}
+
+bool isLoginLocked(uint32_t ip, uint32_t& retryAfter) {
+    unsigned long now = millis();
+    RateClient& client = findRateClient(ip, now);
+    if (!client.loginLocked) return false;
+    
+    unsigned long elapsed = now - client.lockedAt;
+    if (elapsed >= LOGIN_LOCKOUT_MS) {
+        client.loginLocked = false;
+        return false;
+    }
+    retryAfter = (LOGIN_LOCKOUT_MS - elapsed + 999) / 1000;
+    return true;
+}
+
+uint8_t recordLoginFailure(uint32_t ip) {
+    unsigned long now = millis();
+    RateClient& client = findRateClient(ip, now);
+    uint8_t failures = ++client.loginFailures;
+    if (failures >= LOGIN_MAX_FAILURES) {
+        client.loginFailures = 0;
+        client.loginLocked = true;
+        client.lockedAt = now;
+    }
+    return failures;
+}
+
+void clearLoginFailures(uint32_t ip) {
+    RateClient& client = findRateClient(ip, millis());
+    client.loginFailures = 0;
+}
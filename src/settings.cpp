@@ -3,11 +3,26 @@
 #include "settings.h"
 #include "log_system.h"
 #include "crypto_utils.h"
+#include "auth_system.h"
 #include <Preferences.h>
 
-WebServer server(80);
+AsyncWebServer server(80);
 Settings settings;
 
+static volatile uint32_t configVersion = 1;
+static portMUX_TYPE configVersionMux = portMUX_INITIALIZER_UNLOCKED;
+
+uint32_t getConfigVersion() {
+    return configVersion;
+}
+
+// Farklı task'lardan çağrılabilir (web, UART)
+void bumpConfigVersion() {
+    portENTER_CRITICAL(&configVersionMux);
+    configVersion++;
+    portEXIT_CRITICAL(&configVersionMux);
+}
+
 void loadSettings() {
     Preferences prefs;
     prefs.begin("app-settings", true);  // Read-only
@@ -38,12 +53,10 @@ void loadSettings() {
 
     prefs.end();
 
-    // Session ayarları
-    settings.isLoggedIn = false;
-    settings.sessionStartTime = 0;
+    // Session ayarları - oturum başına hareketsizlik süresi
     settings.SESSION_TIMEOUT = 3600000; // 60 dakika (30 yerine)
 
-    addLog("Ayarlar yüklendi", INFO, "SETTINGS");
+    LOGI(LOG_SRC_SETTINGS, LT_SETTINGS_LOADED);
 }
 
 bool saveSettings(const String& newDevName, const String& newTmName, 
@@ -79,14 +92,15 @@ bool saveSettings(const String& newDevName, const String& newTmName,
         prefs.putString("p_salt", settings.passwordSalt);
         prefs.putString("p_hash", settings.passwordHash);
         
-        // Oturumu kapat
-        settings.isLoggedIn = false;
+        // Tüm oturumları kapat
+        endAllSessions();
         
-        addLog("Şifre değiştirildi", INFO, "SETTINGS");
+        LOGI(LOG_SRC_SETTINGS, LT_SETTINGS_PASSWORD_CHANGED);
     }
 
     prefs.end();
-    addLog("Ayarlar kaydedildi", SUCCESS, "SETTINGS");
+    bumpConfigVersion();
+    LOGS(LOG_SRC_SETTINGS, LT_SETTINGS_SAVED);
     return true;
 }
 
@@ -104,8 +118,8 @@ void initEthernet() {
     }
     
     if (ETH.linkUp()) {
-        addLog("Ethernet OK: " + ETH.localIP().toString(), SUCCESS, "ETH");
+        LOGS(LOG_SRC_ETH, LT_ETH_OK, ETH.localIP());
     } else {
-        addLog("Ethernet kablosu takılı değil", WARN, "ETH");
+        LOGW(LOG_SRC_ETH, LT_ETH_NO_CABLE);
     }
 }
\ No newline at end of file
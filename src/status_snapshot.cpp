@@ -0,0 +1,212 @@
+#include "status_snapshot.h"
+#include "settings.h"
+#include "json_writer.h"
+#include "websocket_handler.h"
+#include "log_system.h"
+#include <esp_rom_crc.h>
+
+// External fonksiyonlar
+extern String getCurrentDateTime();
+extern String getUptime();
+extern bool isTimeSynced();
+extern Settings settings;
+extern bool ntpConfigured;
+
+static StatusSnapshot snapshots[2];
+static volatile uint8_t published = 0;   // Okuyucuların gördüğü tampon
+static portMUX_TYPE snapshotMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t snapshotTaskHandle = NULL;
+
+// Sabit tampona yazan Print - taşarsa görüntü yayınlanmaz
+class SnapshotPrint : public Print {
+public:
+    SnapshotPrint(char* buffer, size_t capacity) : buffer(buffer), capacity(capacity), length(0), overflow(false) {}
+    
+    size_t write(uint8_t c) override {
+        return write(&c, 1);
+    }
+    
+    size_t write(const uint8_t* data, size_t size) override {
+        if (length + size > capacity) {
+            overflow = true;
+            return 0;
+        }
+        memcpy(buffer + length, data, size);
+        length += size;
+        return size;
+    }
+    
+    char* buffer;
+    size_t capacity;
+    size_t length;
+    bool overflow;
+};
+
+// MessagePack karşılıkları - sadece durumda geçen türler
+static void packHeader(SnapshotPrint& out, uint8_t type, uint32_t value, uint8_t bytes) {
+    uint8_t header[5] = {type};
+    for (uint8_t i = 0; i < bytes; i++) {
+        header[1 + i] = value >> (8 * (bytes - 1 - i));
+    }
+    out.write(header, 1 + bytes);
+}
+
+static void packString(SnapshotPrint& out, const char* str, size_t length) {
+    if (length < 32) packHeader(out, 0xa0 | length, 0, 0);
+    else if (length < 256) packHeader(out, 0xd9, length, 1);
+    else packHeader(out, 0xda, length, 2);
+    out.write((const uint8_t*)str, length);
+}
+
+static void packValue(SnapshotPrint& out, const char* str) { packString(out, str, strlen(str)); }
+static void packValue(SnapshotPrint& out, const String& str) { packString(out, str.c_str(), str.length()); }
+static void packValue(SnapshotPrint& out, bool flag) { packHeader(out, flag ? 0xc3 : 0xc2, 0, 0); }
+
+static void packValue(SnapshotPrint& out, unsigned long number) {
+    if (number < 0x80) packHeader(out, number, 0, 0);
+    else if (number <= 0xFF) packHeader(out, 0xcc, number, 1);
+    else if (number <= 0xFFFF) packHeader(out, 0xcd, number, 2);
+    else packHeader(out, 0xce, number, 4);
+}
+
+static void packValue(SnapshotPrint& out, long number) {
+    if (number >= 0) packValue(out, (unsigned long)number);
+    else if (number >= -32) packHeader(out, (uint8_t)number, 0, 0);
+    else packHeader(out, 0xd2, (uint32_t)number, 4);
+}
+
+static void packValue(SnapshotPrint& out, int number) { packValue(out, (long)number); }
+
+// Alanı iki biçimde yaz ve yerlerini/CRC'sini kaydet
+template <typename T>
+static void statusField(JsonWriter& json, SnapshotPrint& out, SnapshotPrint& packed,
+                        StatusSnapshot& target, const char* name, const T& value) {
+    // Fazla alan yamalarda izlenemez - görüntü hiç yayınlanmaz
+    if (target.fieldCount >= STATUS_FIELD_MAX) {
+        out.overflow = true;
+        return;
+    }
+    size_t start = out.length;
+    size_t packedStart = packed.length;
+    json.field(name, value);
+    packValue(packed, name);
+    packValue(packed, value);
+    if (out.overflow || packed.overflow) return;
+    
+    if (start < out.length && out.buffer[start] == ',') start++;
+    StatusField& field = target.fields[target.fieldCount++];
+    field.offset = start;
+    field.length = out.length - start;
+    field.packedOffset = packedStart;
+    field.packedLength = packed.length - packedStart;
+    field.hash = esp_rom_crc32_le(0, (const uint8_t*)out.buffer + start, field.length);
+}
+
+static void writeStatus(JsonWriter& json, SnapshotPrint& out, SnapshotPrint& packed,
+                        StatusSnapshot& target, uint32_t version) {
+    target.fieldCount = 0;
+    json.beginObject();
+    json.field("type", "status");
+    json.field("version", (unsigned long)version);
+    
+    // map16 - eleman sayısı alanlar yazıldıktan sonra doldurulur
+    packHeader(packed, 0xde, 0, 2);
+    packValue(packed, "type");
+    packValue(packed, "status");
+    packValue(packed, "version");
+    packHeader(packed, 0xce, version, 4);
+    
+    statusField(json, out, packed, target, "datetime", getCurrentDateTime());
+    statusField(json, out, packed, target, "uptime", getUptime());
+    statusField(json, out, packed, target, "deviceName", settings.deviceName);
+    statusField(json, out, packed, target, "tmName", settings.transformerStation);
+    statusField(json, out, packed, target, "deviceIP", settings.local_IP.toString());
+    statusField(json, out, packed, target, "baudRate", settings.currentBaudRate);
+    statusField(json, out, packed, target, "ethernetStatus", ETH.linkUp() ? "Bağlı" : "Yok");
+    statusField(json, out, packed, target, "ntpConfigStatus", ntpConfigured ? "Aktif" : "Pasif");
+    statusField(json, out, packed, target, "backendStatus", isTimeSynced() ? "Aktif" : "Pasif");
+    statusField(json, out, packed, target, "timeSynced", isTimeSynced());
+    statusField(json, out, packed, target, "freeHeap", (unsigned long)ESP.getFreeHeap());
+    statusField(json, out, packed, target, "wsClients", getWebSocketClientCount());
+    json.endObject();
+    
+    if (!packed.overflow) {
+        uint16_t entries = 2 + target.fieldCount;
+        packed.buffer[1] = entries >> 8;
+        packed.buffer[2] = entries & 0xFF;
+    }
+}
+
+// Yayında olmayan tamponu doldur ve yayınla. O tampon hâlâ okunuyorsa
+// (yavaş bir HTTP istemcisi) bu tick atlanır, eski görüntü geçerli kalır.
+static void publishStatusSnapshot() {
+    uint8_t back = published ^ 1;
+    StatusSnapshot& target = snapshots[back];
+    if (target.readers > 0) return;
+    
+    uint32_t version = snapshots[published].version + 1;
+    SnapshotPrint out(target.json, STATUS_SNAPSHOT_MAX);
+    SnapshotPrint packed((char*)target.packed, STATUS_SNAPSHOT_MAX);
+    JsonWriter json(out);
+    writeStatus(json, out, packed, target, version);
+    
+    if (out.overflow || packed.overflow) {
+        LOGW(LOG_SRC_SYSTEM, LT_STATUS_SNAPSHOT_OVERFLOW, STATUS_SNAPSHOT_MAX);
+        return;
+    }
+    target.length = out.length;
+    target.packedLength = packed.length;
+    target.version = version;
+    
+    portENTER_CRITICAL(&snapshotMux);
+    published = back;
+    portEXIT_CRITICAL(&snapshotMux);
+}
+
+static void statusSnapshotTask(void *parameter) {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STATUS_SNAPSHOT_INTERVAL));
+        publishStatusSnapshot();
+    }
+}
+
+void initStatusSnapshot() {
+    if (snapshotTaskHandle != NULL) return;
+    
+    // İlk görüntü hazır olmadan okuyucu gelmesin
+    publishStatusSnapshot();
+    
+    xTaskCreatePinnedToCore(
+        statusSnapshotTask,
+        "Status",
+        4096,
+        NULL,
+        tskIDLE_PRIORITY + 1,
+        &snapshotTaskHandle,
+        0  // Core 0
+    );
+}
+
+void refreshStatusSnapshot() {
+    if (snapshotTaskHandle != NULL) {
+        xTaskNotifyGive(snapshotTaskHandle);
+    }
+}
+
+const StatusSnapshot* acquireStatusSnapshot() {
+    portENTER_CRITICAL(&snapshotMux);
+    StatusSnapshot* snapshot = &snapshots[published];
+    snapshot->readers++;
+    portEXIT_CRITICAL(&snapshotMux);
+    return snapshot;
+}
+
+void releaseStatusSnapshot(const StatusSnapshot* snapshot) {
+    portENTER_CRITICAL(&snapshotMux);
+    snapshots[snapshot - snapshots].readers--;
+    portEXIT_CRITICAL(&snapshotMux);
+}
+
+uint32_t getStatusSnapshotVersion() {
+    return snapshots[published].version;
+}
@@ -76,7 +76,7 @@ void updateSystemTime() {
     struct timeval now = { .tv_sec = t };
     settimeofday(&now, NULL);
     
-    addLog("Sistem saati güncellendi", INFO, "TIME");
+    LOGI(LOG_SRC_TIME, LT_TIME_SYSTEM_UPDATED);
 }
 
 // dsPIC'ten gelen zaman verisini parse et
@@ -122,7 +122,7 @@ bool parseTimeResponse(const String& response) {
         }
     }
     
-    addLog("Geçersiz zaman formatı: " + response, WARN, "TIME");
+    LOGW(LOG_SRC_TIME, LT_TIME_BAD_FORMAT, response);
     return false;
 }
 
@@ -132,7 +132,7 @@ bool requestTimeFromDsPIC() {
     
     // Zaman isteği komutu gönder
     if (!sendCustomCommand("GETTIME", response, 2000)) {
-        addLog("❌ dsPIC'ten zaman bilgisi alınamadı", ERROR, "TIME");
+        LOGE(LOG_SRC_TIME, LT_TIME_REQUEST_FAILED);
         return false;
     }
     
@@ -142,7 +142,7 @@ bool requestTimeFromDsPIC() {
         timeData.syncCount++;
         timeData.isValid = true;
         
-        addLog("✅ Zaman senkronize edildi: " + timeData.lastDate + " " + timeData.lastTime, SUCCESS, "TIME");
+        LOGS(LOG_SRC_TIME, LT_TIME_SYNCED, timeData.lastDate, timeData.lastTime);
         
         // Sistem saatini güncelle
         updateSystemTime();
@@ -168,7 +168,7 @@ void checkTimeSync() {
     // Zaman geçerliliğini kontrol et (10 dakika timeout)
     if (timeData.isValid && (now - timeData.lastSync > 600000)) {
         timeData.isValid = false;
-        addLog("⚠️ Zaman senkronizasyonu kaybedildi", WARN, "TIME");
+        LOGW(LOG_SRC_TIME, LT_TIME_SYNC_LOST);
     }
 }
 
@@ -207,4 +207,10 @@ String getTimeSyncStats() {
     stats += "Son Saat: " + timeData.lastTime;
     
     return stats;
+}
+
+// İstatistikleri tek satırlık log kaydı olarak yaz
+void logTimeSyncStats() {
+    unsigned long elapsed = timeData.lastSync > 0 ? (millis() - timeData.lastSync) / 1000 : 0;
+    LOGI(LOG_SRC_TIME, LT_TIME_SYNC_STATS, timeData.isValid ? "Aktif" : "Pasif", timeData.syncCount, elapsed);
 }
\ No newline at end of file
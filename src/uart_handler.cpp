@@ -31,9 +31,8 @@ void initUART() {
     uartErrorCount = 0;
     uartHealthy = true;
     
-    addLog("✅ UART başlatıldı - TX2: IO" + String(UART_TX_PIN) + 
-           ", RX2: IO" + String(UART_RX_PIN) + 
-           ", Baud: " + String(settings.currentBaudRate), SUCCESS, "UART");
+    LOGS(LOG_SRC_UART, LT_UART_STARTED,
+         UART_TX_PIN, UART_RX_PIN, settings.currentBaudRate);
 }
 
 // dsPIC33EP'ye sadece baudrate KODU gönder (cihazın kendi baudrate'i değişmeyecek)
@@ -48,7 +47,7 @@ bool sendBaudRateCommand(long baudRate) {
         case 57600:  command = "br57600";  break;
         case 115200: command = "br115200"; break;
         default:
-            addLog("Geçersiz baudrate kodu: " + String(baudRate), ERROR, "UART");
+            LOGE(LOG_SRC_UART, LT_UART_BAUD_INVALID, baudRate);
             return false;
     }
     
@@ -61,19 +60,19 @@ bool sendBaudRateCommand(long baudRate) {
     UART_PORT.println(command);
     UART_PORT.flush();
     
-    addLog("dsPIC33EP'ye baudrate kodu gönderildi: " + command, INFO, "UART");
+    LOGI(LOG_SRC_UART, LT_UART_BAUD_SENT, command);
     
     // ACK bekle
     String response = safeReadUARTResponse(2000);
     
     if (response == "ACK" || response.indexOf("OK") >= 0) {
-        addLog("✅ Baudrate kodu dsPIC33EP tarafından alındı", SUCCESS, "UART");
+        LOGS(LOG_SRC_UART, LT_UART_BAUD_ACKED);
         return true;
     } else if (response.length() > 0) {
-        addLog("dsPIC33EP yanıtı: " + response, WARN, "UART");
+        LOGW(LOG_SRC_UART, LT_DSPIC_RESPONSE, response);
         return true; // Yanıt varsa başarılı say
     } else {
-        addLog("❌ dsPIC33EP'den yanıt alınamadı", ERROR, "UART");
+        LOGE(LOG_SRC_UART, LT_UART_NO_RESPONSE);
         return false;
     }
 }
@@ -123,12 +122,12 @@ bool requestFirstFault() {
     UART_PORT.println(command);
     UART_PORT.flush();
     
-    addLog("Arıza sorgu komutu: " + command, DEBUG, "UART");
+    LOGD(LOG_SRC_UART, LT_UART_FAULT_QUERY, command);
     
     lastResponse = safeReadUARTResponse(UART_TIMEOUT);
     
     if (lastResponse.length() > 0) {
-        addLog("Arıza kaydı alındı: " + lastResponse.substring(0, 20) + "...", DEBUG, "UART");
+        LOGD(LOG_SRC_UART, LT_UART_FAULT_RECEIVED, lastResponse.substring(0, 20));
         return true;
     }
     
@@ -162,12 +161,12 @@ String getLastFaultResponse() {
 // UART sağlık kontrolü
 void checkUARTHealth() {
     if (millis() - lastUARTActivity > 300000 && uartHealthy) { // 5 dakika
-        addLog("⚠️ UART 5 dakikadır sessiz", WARN, "UART");
+        LOGW(LOG_SRC_UART, LT_UART_SILENT);
         uartHealthy = false;
     }
     
     if (uartErrorCount > 10) {
-        addLog("🔄 UART yeniden başlatılıyor...", WARN, "UART");
+        LOGW(LOG_SRC_UART, LT_UART_RESTARTING);
         initUART();
         uartErrorCount = 0;
     }
@@ -198,15 +197,15 @@ bool sendCustomCommand(const String& command, String& response, unsigned long ti
 
 // Test fonksiyonu
 bool testUARTConnection() {
-    addLog("UART bağlantı testi...", INFO, "UART");
+    LOGI(LOG_SRC_UART, LT_UART_TEST_STARTED);
     
     String response;
     bool result = sendCustomCommand("TEST", response, 1000);
     
     if (result) {
-        addLog("✅ UART testi başarılı: " + response, SUCCESS, "UART");
+        LOGS(LOG_SRC_UART, LT_UART_TEST_OK, response);
     } else {
-        addLog("❌ UART testi başarısız", ERROR, "UART");
+        LOGE(LOG_SRC_UART, LT_UART_TEST_FAILED);
     }
     
     return result;
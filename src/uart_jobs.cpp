@@ -0,0 +1,200 @@
+#include "uart_jobs.h"
+#include "uart_handler.h"
+#include "ntp_handler.h"
+#include "settings.h"
+#include "log_system.h"
+
+struct UartJob {
+    int32_t id;
+    UartJobType type;
+    UartJobState state;
+    bool notified;          // Sonuç WebSocket'e yayınlandı mı
+    long arg;
+    unsigned long doneAt;   // Bitiş ya da (yayınlandıysa) yayın zamanı
+    UartJobResult result;
+};
+
+static UartJob jobs[UART_JOB_SLOTS];
+static SemaphoreHandle_t jobMutex = NULL;
+static QueueHandle_t jobQueue = NULL;   // Sıradaki işlerin slot numaraları
+static int32_t nextJobId = 1;
+
+void initUartJobs() {
+    if (jobMutex != NULL) return;
+    
+    jobMutex = xSemaphoreCreateMutex();
+    jobQueue = xQueueCreate(UART_JOB_SLOTS, sizeof(uint8_t));
+    for (int i = 0; i < UART_JOB_SLOTS; i++) {
+        jobs[i].id = 0;
+        jobs[i].state = UART_JOB_FREE;
+    }
+}
+
+static void freeJobLocked(uint8_t slot) {
+    jobs[slot].state = UART_JOB_FREE;
+    jobs[slot].result.response = "";
+}
+
+// Sahibi gelmeyen (ör. bağlantısı kopan istemci) sonuçları temizle - mutex altında.
+// WebSocket'e yayınlanan sonucu istemci zaten aldı; kısa bir poll payı kalır.
+static void expireUartJobs() {
+    unsigned long now = millis();
+    for (int i = 0; i < UART_JOB_SLOTS; i++) {
+        if (jobs[i].state != UART_JOB_DONE) continue;
+        unsigned long ttl = jobs[i].notified ? UART_JOB_NOTIFIED_TTL : UART_JOB_RESULT_TTL;
+        if (now - jobs[i].doneAt > ttl) freeJobLocked(i);
+    }
+}
+
+// Boş slot, yoksa yayınlanmış en eski sonucun slotu - mutex altında
+static int findJobSlotLocked() {
+    int reclaim = -1;
+    for (int i = 0; i < UART_JOB_SLOTS; i++) {
+        if (jobs[i].state == UART_JOB_FREE) return i;
+        if (jobs[i].state == UART_JOB_DONE && jobs[i].notified &&
+            (reclaim < 0 || (long)(jobs[reclaim].doneAt - jobs[i].doneAt) > 0)) {
+            reclaim = i;
+        }
+    }
+    return reclaim;
+}
+
+int32_t submitUartJob(UartJobType type, long arg) {
+    if (jobMutex == NULL) return -1;
+    
+    int32_t id = -1;
+    xSemaphoreTake(jobMutex, portMAX_DELAY);
+    expireUartJobs();
+    int slot = findJobSlotLocked();
+    if (slot >= 0) {
+        uint8_t i = slot;
+        id = nextJobId++;
+        if (nextJobId <= 0) nextJobId = 1;
+        jobs[i].id = id;
+        jobs[i].type = type;
+        jobs[i].arg = arg;
+        jobs[i].state = UART_JOB_QUEUED;
+        jobs[i].notified = false;
+        jobs[i].result.success = false;
+        jobs[i].result.response = "";
+        xQueueSend(jobQueue, &i, 0);  // Kuyruk slot sayısı kadar, dolamaz
+    }
+    xSemaphoreGive(jobMutex);
+    
+    if (id < 0) {
+        LOGW(LOG_SRC_UART, LT_UART_JOB_QUEUE_FULL, (int)type);
+    }
+    return id;
+}
+
+UartJobState pollUartJob(int32_t id, UartJobInfo& out) {
+    out.state = UART_JOB_FREE;
+    if (jobMutex == NULL || id <= 0) return out.state;
+    
+    xSemaphoreTake(jobMutex, portMAX_DELAY);
+    expireUartJobs();
+    for (int i = 0; i < UART_JOB_SLOTS; i++) {
+        if (jobs[i].id != id || jobs[i].state == UART_JOB_FREE) continue;
+        
+        out.id = id;
+        out.type = jobs[i].type;
+        out.state = jobs[i].state;
+        if (jobs[i].state == UART_JOB_DONE) {
+            // Sonuç teslim edildi - slot boşalır
+            out.result = jobs[i].result;
+            freeJobLocked(i);
+        }
+        break;
+    }
+    xSemaphoreGive(jobMutex);
+    return out.state;
+}
+
+bool takeUartJobNotification(UartJobInfo& out) {
+    if (jobMutex == NULL) return false;
+    
+    bool found = false;
+    xSemaphoreTake(jobMutex, portMAX_DELAY);
+    for (int i = 0; i < UART_JOB_SLOTS; i++) {
+        if (jobs[i].state != UART_JOB_DONE || jobs[i].notified) continue;
+        
+        jobs[i].notified = true;
+        jobs[i].doneAt = millis();
+        out.id = jobs[i].id;
+        out.type = jobs[i].type;
+        out.state = UART_JOB_DONE;
+        out.result = jobs[i].result;
+        found = true;
+        break;
+    }
+    xSemaphoreGive(jobMutex);
+    return found;
+}
+
+const char* uartJobTypeToString(UartJobType type) {
+    switch (type) {
+        case UART_JOB_FAULT_FIRST:  return "fault_first";
+        case UART_JOB_FAULT_NEXT:   return "fault_next";
+        case UART_JOB_SET_BAUDRATE: return "baudrate";
+        case UART_JOB_SEND_NTP:     return "ntp";
+        case UART_JOB_TEST:         return "uart_test";
+    }
+    return "unknown";
+}
+
+const char* uartJobStateToString(UartJobState state) {
+    switch (state) {
+        case UART_JOB_QUEUED:  return "queued";
+        case UART_JOB_RUNNING: return "running";
+        case UART_JOB_DONE:    return "done";
+        default:               return "unknown";
+    }
+}
+
+// İşi yürüt - UART'a sadece UART task'ı dokunur, mutex tutulmaz
+static void executeUartJob(UartJobType type, long arg, UartJobResult& result) {
+    switch (type) {
+        case UART_JOB_FAULT_FIRST:
+        case UART_JOB_FAULT_NEXT:
+            result.success = type == UART_JOB_FAULT_FIRST ? requestFirstFault() : requestNextFault();
+            if (result.success) result.response = getLastFaultResponse();
+            break;
+        case UART_JOB_SET_BAUDRATE:
+            result.success = changeBaudRate(arg);
+            if (result.success) bumpConfigVersion();
+            break;
+        case UART_JOB_SEND_NTP:
+            result.success = sendNTPConfigToBackend();
+            break;
+        case UART_JOB_TEST:
+            result.success = testUARTConnection();
+            break;
+    }
+}
+
+void runUartJobs(TickType_t wait) {
+    if (jobQueue == NULL) {
+        vTaskDelay(wait);
+        return;
+    }
+    
+    uint8_t slot;
+    while (xQueueReceive(jobQueue, &slot, wait) == pdTRUE) {
+        xSemaphoreTake(jobMutex, portMAX_DELAY);
+        UartJobType type = jobs[slot].type;
+        long arg = jobs[slot].arg;
+        jobs[slot].state = UART_JOB_RUNNING;
+        xSemaphoreGive(jobMutex);
+        
+        UartJobResult result = {false, ""};
+        executeUartJob(type, arg, result);
+        
+        xSemaphoreTake(jobMutex, portMAX_DELAY);
+        jobs[slot].result = result;
+        jobs[slot].doneAt = millis();
+        jobs[slot].state = UART_JOB_DONE;
+        xSemaphoreGive(jobMutex);
+        
+        wait = 0;  // Birikmiş işleri bitir, sonra periyodik kontrollere dön
+    }
+}
@@ -50,7 +50,7 @@ uint8_t calculateXORChecksum(const uint8_t* data, size_t length) {
 // Frame oluşturma
 bool createFrame(UARTFrame& frame, uint8_t command, const uint8_t* data, uint16_t dataLength) {
     if (dataLength > MAX_FRAME_SIZE) {
-        addLog("❌ Frame verisi çok büyük: " + String(dataLength), ERROR, "UART");
+        LOGE(LOG_SRC_UART, LT_UART_FRAME_TOO_LARGE, dataLength);
         return false;
     }
     
@@ -120,7 +120,7 @@ bool sendFrame(const UARTFrame& frame) {
     
     Serial2.flush();
     
-    addLog("📤 Frame gönderildi - Cmd: 0x" + String(frame.command, HEX) + ", Len: " + String(frame.dataLength), DEBUG, "UART");
+    LOGD(LOG_SRC_UART, LT_UART_FRAME_SENT, frame.command, frame.dataLength);
     
     return true;
 }
@@ -160,10 +160,10 @@ bool receiveFrame(UARTFrame& frame, unsigned long timeout) {
                     uint8_t calculatedChecksum = calculateXORChecksum(checksumData, checksumIndex);
                     
                     if (calculatedChecksum == frame.checksum) {
-                        addLog("✅ Frame alındı - Cmd: 0x" + String(frame.command, HEX) + ", Len: " + String(frame.dataLength), DEBUG, "UART");
+                        LOGD(LOG_SRC_UART, LT_UART_FRAME_RECEIVED, frame.command, frame.dataLength);
                         return true;
                     } else {
-                        addLog("❌ Checksum hatası! Beklenen: 0x" + String(calculatedChecksum, HEX) + ", Alınan: 0x" + String(frame.checksum, HEX), ERROR, "UART");
+                        LOGE(LOG_SRC_UART, LT_UART_CHECKSUM_ERROR, calculatedChecksum, frame.checksum);
                         return false;
                     }
                 }
@@ -192,7 +192,7 @@ bool receiveFrame(UARTFrame& frame, unsigned long timeout) {
                     checksumData[checksumIndex++] = byte;
                     
                     if (frame.dataLength > MAX_FRAME_SIZE) {
-                        addLog("❌ Frame verisi çok büyük: " + String(frame.dataLength), ERROR, "UART");
+                        LOGE(LOG_SRC_UART, LT_UART_FRAME_TOO_LARGE, frame.dataLength);
                         return false;
                     }
                     
@@ -228,7 +228,7 @@ bool receiveFrame(UARTFrame& frame, unsigned long timeout) {
         delay(1);
     }
     
-    addLog("⏱️ Frame okuma timeout", WARN, "UART");
+    LOGW(LOG_SRC_UART, LT_UART_FRAME_TIMEOUT);
     return false;
 }
 
@@ -266,7 +266,7 @@ bool requestTimeWithProtocol() {
     if (sendCommandWithProtocol(CMD_GET_TIME, "", response, 2000)) {
         // Response formatı: "DDMMYYHHMMSS"
         if (response.length() == 12) {
-            addLog("✅ Zaman bilgisi alındı: " + response, SUCCESS, "UART");
+            LOGS(LOG_SRC_UART, LT_UART_TIME_RECEIVED, response);
             return true;
         }
     }
@@ -279,7 +279,7 @@ bool sendNTPConfigWithProtocol(const String& server1, const String& server2) {
     
     if (sendCommandWithProtocol(CMD_SET_NTP, data, response, 2000)) {
         if (response == "ACK") {
-            addLog("✅ NTP config gönderildi", SUCCESS, "UART");
+            LOGS(LOG_SRC_UART, LT_UART_NTP_SENT);
             return true;
         }
     }
@@ -290,7 +290,7 @@ bool requestFirstFaultWithProtocol() {
     String response;
     if (sendCommandWithProtocol(CMD_GET_FIRST_FAULT, "", response, 3000)) {
         if (response.length() > 0) {
-            addLog("✅ İlk arıza kaydı alındı", SUCCESS, "UART");
+            LOGS(LOG_SRC_UART, LT_UART_FIRST_FAULT);
             // Response'u global değişkene kaydet
             lastResponse = response;
             return true;
@@ -303,7 +303,7 @@ bool requestNextFaultWithProtocol() {
     String response;
     if (sendCommandWithProtocol(CMD_GET_NEXT_FAULT, "", response, 3000)) {
         if (response.length() > 0) {
-            addLog("✅ Sonraki arıza kaydı alındı", SUCCESS, "UART");
+            LOGS(LOG_SRC_UART, LT_UART_NEXT_FAULT);
             lastResponse = response;
             return true;
         }
@@ -335,15 +335,15 @@ void checkUARTHealthWithProtocol() {
             consecutiveFailures = 0;
             if (!uartHealthy) {
                 uartHealthy = true;
-                addLog("✅ UART bağlantısı düzeldi", SUCCESS, "UART");
+                LOGS(LOG_SRC_UART, LT_UART_LINK_RESTORED);
             }
         } else {
             consecutiveFailures++;
-            addLog("⚠️ UART ping başarısız (#" + String(consecutiveFailures) + ")", WARN, "UART");
+            LOGW(LOG_SRC_UART, LT_UART_PING_FAILED, consecutiveFailures);
             
             if (consecutiveFailures >= 3) {
                 uartHealthy = false;
-                addLog("❌ UART bağlantısı kayıp", ERROR, "UART");
+                LOGE(LOG_SRC_UART, LT_UART_LINK_LOST);
                 
                 // UART'ı yeniden başlat
                 if (consecutiveFailures >= 5) {
@@ -3,12 +3,21 @@
 #include "settings.h"
 #include "ntp_handler.h"
 #include "uart_handler.h"
+#include "uart_jobs.h"
 #include "log_system.h"
+#include "log_storage.h"
+#include "json_writer.h"
+#include "chunked_response.h"
+#include "http_metrics.h"
+#include "websocket_handler.h"
+#include "status_snapshot.h"
 #include "backup_restore.h"      // Yeni eklenen
 #include "password_policy.h"     // Yeni eklenen
+#include "web_assets.h"          // Derleme öncesi üretilir (scripts/build_web_assets.py)
 #include <LittleFS.h>
-#include <WebServer.h>
+#include <ESPAsyncWebServer.h>
 #include <ArduinoJson.h>
+#include <StreamString.h>
 
 // External fonksiyonlar - time_sync.cpp'den
 extern String getCurrentDateTime();
@@ -16,73 +25,104 @@ extern String getCurrentDate();
 extern String getCurrentTime();
 extern bool isTimeSynced();
 
-extern WebServer server;
+extern AsyncWebServer server;
 extern Settings settings;
 extern bool ntpConfigured;
 
-// Cache için statik değişkenler
-static String cachedIndexHtml = "";
-static String cachedStyleCss = "";
-static String cachedScriptJs = "";
-static bool filesLoaded = false;
+// Statik dosyalar derleme öncesi küçültülüp gzip'lenir ve firmware'e gömülür
+// (web_assets.h). CSS/JS içerik hash'li adlarla sunulur, içerik değişince
+// adları da değişir.
+#define CACHE_CONTROL_IMMUTABLE  "public, max-age=31536000, immutable"
+#define CACHE_CONTROL_REVALIDATE "no-cache"
+#define CACHE_CONTROL_PRIVATE    "private, no-cache"
 
-// Dosyaları belleğe yükle (bir kez)
-void loadFilesToMemory() {
-    if (filesLoaded) return;
-    
-    // HTML dosyalarını yükle
-    File file = LittleFS.open("/index.html", "r");
-    if (file) {
-        cachedIndexHtml = file.readString();
-        file.close();
-    }
-    
-    file = LittleFS.open("/style.css", "r");
-    if (file) {
-        cachedStyleCss = file.readString();
-        file.close();
+#define BATCH_MAX_REQUESTS  8    // /api/batch başına en fazla alt istek
+
+// O(1) arama - üretilmiş mükemmel hash tek bir aday verir, tek strcmp ile doğrulanır
+static const WebAsset* findWebAsset(const char* path) {
+    int8_t index = WEB_ASSET_SLOTS[webAssetHash(path) % WEB_ASSET_HASH_SIZE];
+    if (index < 0 || strcmp(WEB_ASSETS[index].path, path) != 0) return NULL;
+    return &WEB_ASSETS[index];
+}
+
+// Statik dosya servisi - doğrudan flash'tan, heap kopyası ve dosya sistemi yok
+static void serveWebAsset(AsyncWebServerRequest* request, const WebAsset* asset) {
+    const char* cacheControl = asset->immutable ? CACHE_CONTROL_IMMUTABLE : CACHE_CONTROL_REVALIDATE;
+    
+    // Tarayıcıdaki kopya güncel - gövde gönderilmez
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == asset->etag) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", asset->etag);
+        response->addHeader("Cache-Control", cacheControl);
+        request->send(response);
+        return;
     }
     
-    file = LittleFS.open("/script.js", "r");
-    if (file) {
-        cachedScriptJs = file.readString();
-        file.close();
+    AsyncWebServerResponse* response = request->beginResponse(200, asset->contentType,
+                                                               asset->data, asset->length);
+    addHttpRouteBytes(activeHttpRoute(), asset->length);
+    if (asset->gzip) {
+        response->addHeader("Content-Encoding", "gzip");
     }
-    
-    filesLoaded = true;
+    response->addHeader("ETag", asset->etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
 }
 
-// Hızlı statik dosya servisi
-void serveCachedFile(const String& filename, const String& contentType) {
-    // Cache'ten sun
-    if (filename == "/index.html" && cachedIndexHtml.length() > 0) {
-        server.send(200, contentType, cachedIndexHtml);
-        return;
+// Tüm sayfa ve varlıklar için tek giriş noktası: arama, oturum kontrolü, servis
+static void handleStaticRequest(AsyncWebServerRequest* request) {
+    const WebAsset* asset = NULL;
+    if (request->method() == HTTP_GET) {
+        asset = findWebAsset(request->url().c_str());
     }
-    if (filename == "/style.css" && cachedStyleCss.length() > 0) {
-        server.send(200, contentType, cachedStyleCss);
+    if (asset == NULL) {
+        request->send(404, "text/plain", "404: Not Found");
         return;
     }
-    if (filename == "/script.js" && cachedScriptJs.length() > 0) {
-        server.send(200, contentType, cachedScriptJs);
+    
+    if (asset->auth == WEB_AUTH_SESSION && !checkSession(request)) {
+        request->redirect("/login");
         return;
     }
-    
-    // Cache'te yoksa dosyadan oku
-    if (!LittleFS.exists(filename)) {
-        server.send(404, "text/plain", "404: Not Found");
+    if (asset->auth == WEB_AUTH_GUEST && checkSession(request)) {
+        request->redirect("/");
         return;
     }
     
-    File file = LittleFS.open(filename, "r");
-    if (!file) {
-        server.send(500, "text/plain", "500: File Error");
+    serveWebAsset(request, asset);
+}
+
+// UART'a bağlı istekler beklemez: iş UART task'ına verilir ve hemen
+// 202 + iş id'si döner. Sonuç WebSocket "job" olayıyla gelir ya da
+// GET /api/jobs/{id} ile sorgulanır.
+static void writeUartJobJson(JsonWriter& json, const UartJobInfo& job) {
+    json.beginObject();
+    json.field("id", (long)job.id);
+    json.field("job", uartJobTypeToString(job.type));
+    json.field("state", uartJobStateToString(job.state));
+    if (job.state == UART_JOB_DONE) {
+        json.field("success", job.result.success);
+        json.field("response", job.result.response);
+    }
+    json.endObject();
+}
+
+static void submitJobResponse(AsyncWebServerRequest* request, UartJobType type, long arg = 0) {
+    int32_t jobId = submitUartJob(type, arg);
+    if (jobId < 0) {
+        sendJsonError(request, 503, "UART iş kuyruğu dolu");
         return;
     }
     
-    // Chunked transfer kullan (daha hızlı)
-    server.streamFile(file, contentType);
-    file.close();
+    JsonResponse* body = new JsonResponse();
+    JsonWriter& json = body->json;
+    json.beginObject();
+    json.field("jobId", (long)jobId);
+    json.field("job", uartJobTypeToString(type));
+    json.field("state", uartJobStateToString(UART_JOB_QUEUED));
+    json.endObject();
+    
+    sendJson(request, body, 202);
 }
 
 String getUptime() {
@@ -94,332 +134,816 @@ String getUptime() {
 
 // API Handler'lar - Optimize edildi
 
-void handleStatusAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+// Salt okunur gövdeler ayrı yazılır - hem kendi rotaları hem /api/batch kullanır
+
+// Durum, üretici task'ın hazırladığı görüntüden kopyalanır - istek başına serileştirme yok
+static void writeStatusJson(JsonWriter& json) {
+    const StatusSnapshot* snapshot = acquireStatusSnapshot();
+    json.rawValue(snapshot->json, snapshot->length);
+    releaseStatusSnapshot(snapshot);
+}
+
+static void writeSettingsJson(JsonWriter& json) {
+    json.beginObject();
+    json.field("deviceName", settings.deviceName);
+    json.field("tmName", settings.transformerStation);
+    json.field("username", settings.username);
+    json.endObject();
+}
+
+static void writeNtpJson(JsonWriter& json) {
+    json.beginObject();
+    json.field("ntpServer1", (const char*)ntpConfig.ntpServer1);
+    json.field("ntpServer2", (const char*)ntpConfig.ntpServer2);
+    json.field("timezone", ntpConfig.timezone);
+    json.endObject();
+}
+
+static void writeBaudRateJson(JsonWriter& json) {
+    json.beginObject();
+    json.field("baudRate", settings.currentBaudRate);
+    json.endObject();
+}
+
+// Yapılandırma GET'leri (ayarlar, NTP, baudrate): gövde sürüm başına bir kez
+// üretilir, ETag sürümden türetilir. Önbellek sadece async_tcp task'ında kullanılır.
+struct ConfigCache {
+    void (*write)(JsonWriter&);
+    uint32_t version;    // 0: henüz üretilmedi
+    String body;
+};
+
+static ConfigCache settingsCache = {writeSettingsJson, 0, String()};
+static ConfigCache ntpCache = {writeNtpJson, 0, String()};
+static ConfigCache baudRateCache = {writeBaudRateJson, 0, String()};
+
+// Açılışta rastgele - yeniden başlatma sonrası eski ETag'ler eşleşmez
+static uint32_t configEpoch = 0;
+
+static String configETag() {
+    char etag[24];
+    snprintf(etag, sizeof(etag), "\"%08lx-%lu\"", (unsigned long)configEpoch,
+             (unsigned long)getConfigVersion());
+    return String(etag);
+}
+
+static const String& renderConfig(ConfigCache& cache) {
+    // Sürüm önce okunur: üretim sırasında artarsa sonraki istek yeniden üretir
+    uint32_t version = getConfigVersion();
+    if (cache.version != version) {
+        StreamString out;
+        JsonWriter json(out);
+        cache.write(json);
+        cache.body = out;
+        cache.version = version;
+    }
+    return cache.body;
+}
+
+static void sendConfig(AsyncWebServerRequest* request, ConfigCache& cache) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    // Static JSON buffer kullan (heap yerine stack)
-    char json[512];
-    snprintf(json, sizeof(json),
-        "{\"datetime\":\"%s\","
-        "\"uptime\":\"%s\","
-        "\"deviceName\":\"%s\","
-        "\"tmName\":\"%s\","
-        "\"deviceIP\":\"%s\","
-        "\"baudRate\":%ld,"
-        "\"ethernetStatus\":\"%s\","
-        "\"ntpConfigStatus\":\"%s\","
-        "\"backendStatus\":\"%s\"}",
-        getCurrentDateTime().c_str(),
-        getUptime().c_str(),
-        settings.deviceName.c_str(),
-        settings.transformerStation.c_str(),
-        settings.local_IP.toString().c_str(),
-        settings.currentBaudRate,
-        ETH.linkUp() ? "Bağlı" : "Yok",
-        ntpConfigured ? "Aktif" : "Pasif",
-        isTimeSynced() ? "Aktif" : "Pasif"
-    );
-    
-    server.send(200, "application/json", json);
-}
-
-void handleGetSettingsAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+    String etag = configETag();
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", etag);
+        response->addHeader("Cache-Control", CACHE_CONTROL_PRIVATE);
+        request->send(response);
         return;
     }
     
-    char json[256];
-    snprintf(json, sizeof(json),
-        "{\"deviceName\":\"%s\",\"tmName\":\"%s\",\"username\":\"%s\"}",
-        settings.deviceName.c_str(),
-        settings.transformerStation.c_str(),
-        settings.username.c_str()
-    );
-    
-    server.send(200, "application/json", json);
+    const String& body = renderConfig(cache);
+    AsyncWebServerResponse* response = request->beginResponse(200, "application/json", body);
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", CACHE_CONTROL_PRIVATE);
+    addHttpRouteBytes(activeHttpRoute(), body.length());
+    request->send(response);
+}
+
+// /api/batch için önbellekteki gövdeyi aynen yaz
+static void writeConfig(JsonWriter& json, ConfigCache& cache) {
+    const String& body = renderConfig(cache);
+    json.rawValue(body.c_str(), body.length());
 }
 
-void handlePostSettingsAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+static void writeCachedSettingsJson(JsonWriter& json) { writeConfig(json, settingsCache); }
+static void writeCachedNtpJson(JsonWriter& json) { writeConfig(json, ntpCache); }
+static void writeCachedBaudRateJson(JsonWriter& json) { writeConfig(json, baudRateCache); }
+
+// Salt okunur gövdeyi kendi yanıtı olarak gönder
+static void sendReadOnly(AsyncWebServerRequest* request, void (*write)(JsonWriter&)) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    if (!saveSettings(
-        server.arg("deviceName"),
-        server.arg("tmName"),
-        server.arg("username"),
-        server.arg("password")
-    )) {
-        server.send(400, "text/plain", "Error");
+    JsonResponse* body = new JsonResponse();
+    write(body->json);
+    sendJson(request, body);
+}
+
+// Büyük salt okunur gövde - parça parça üretilir
+static void sendReadOnlySteps(AsyncWebServerRequest* request, JsonStepWriter writer) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    server.send(200, "text/plain", "OK");
+    sendJsonSteps(request, writer);
 }
 
-void handleFaultRequest(bool isFirst) {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+void handleStatusAPI(AsyncWebServerRequest* request) {
+    sendReadOnly(request, writeStatusJson);
+}
+
+void handleGetSettingsAPI(AsyncWebServerRequest* request) {
+    sendConfig(request, settingsCache);
+}
+
+void handlePostSettingsAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    bool success = isFirst ? requestFirstFault() : requestNextFault();
-    
-    if (success) {
-        String response = getLastFaultResponse();
-        server.send(200, "text/plain", response);
-    } else {
-        server.send(500, "text/plain", "Error");
+    if (!saveSettings(
+        request->arg("deviceName"),
+        request->arg("tmName"),
+        request->arg("username"),
+        request->arg("password")
+    )) {
+        request->send(400, "text/plain", "Error");
+        return;
     }
+    
+    refreshStatusSnapshot();   // Cihaz/TM adı durumda da görünür
+    request->send(200, "text/plain", "OK");
 }
 
-void handleGetNtpAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+void handleFaultRequest(AsyncWebServerRequest* request, bool isFirst) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    char json[256];
-    snprintf(json, sizeof(json),
-        "{\"ntpServer1\":\"%s\",\"ntpServer2\":\"%s\",\"timezone\":%d}",
-        ntpConfig.ntpServer1,
-        ntpConfig.ntpServer2,
-        ntpConfig.timezone
-    );
-    
-    server.send(200, "application/json", json);
+    submitJobResponse(request, isFirst ? UART_JOB_FAULT_FIRST : UART_JOB_FAULT_NEXT);
 }
 
-void handlePostNtpAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+void handleGetNtpAPI(AsyncWebServerRequest* request) {
+    sendConfig(request, ntpCache);
+}
+
+void handlePostNtpAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
     if (!saveNTPSettings(
-        server.arg("ntpServer1"),
-        server.arg("ntpServer2"),
-        server.arg("timezone").toInt()
+        request->arg("ntpServer1"),
+        request->arg("ntpServer2"),
+        request->arg("timezone").toInt()
     )) {
-        server.send(400, "text/plain", "Error");
+        request->send(400, "text/plain", "Error");
         return;
     }
     
-    sendNTPConfigToBackend();
-    server.send(200, "text/plain", "OK");
+    // Ayar kaydedildi; dsPIC33EP'ye gönderim UART task'ında
+    submitJobResponse(request, UART_JOB_SEND_NTP);
 }
 
-void handleGetBaudRateAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+void handleGetBaudRateAPI(AsyncWebServerRequest* request) {
+    sendConfig(request, baudRateCache);
+}
+
+void handlePostBaudRateAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    char json[64];
-    snprintf(json, sizeof(json), "{\"baudRate\":%ld}", settings.currentBaudRate);
-    server.send(200, "application/json", json);
+    long newBaud = request->arg("baud").toInt();
+    
+    submitJobResponse(request, UART_JOB_SET_BAUDRATE, newBaud);
 }
 
-void handlePostBaudRateAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
-        return;
+// /api/logs yanıtı - her step() bir log kaydı yazar, halka kilidi kayıt
+// başına alınır; yavaş istemci log yazanları bekletmez.
+class LogQueryStream : public ChunkedSource {
+public:
+    uint8_t levelMask = 0;     // 0 = tüm seviyeler
+    uint32_t sourceMask = 0;
+    bool filterSource = false;
+    unsigned long since = 0;
+    unsigned long before = 0;
+    long limit = 50;
+    uint32_t newest = 0;
+    uint32_t id = 0;           // Sıradaki kaydın bir üstü (imleç)
+    
+    LogQueryStream() : json(*this) {}
+    
+protected:
+    bool step() override {
+        if (!started) {
+            json.beginObject();
+            json.key("entries");
+            json.beginArray();
+            started = true;
+            return true;
+        }
+        
+        // Filtreye uyan bir kayıt yazılana veya aralık bitene kadar ilerle
+        LogEntry entry;
+        while (id > getOldestLogId()) {
+            if (count >= limit) {
+                exhausted = false;
+                break;
+            }
+            id--;
+            if (!getLogEntry(id, entry)) break;  // Bu arada üzerine yazıldı
+            
+            if (levelMask != 0 && !(levelMask & (1 << entry.level))) continue;
+            if (filterSource && !(sourceMask & (1UL << entry.source))) continue;
+            if ((since > 0 || before > 0) && entry.epoch == 0) continue;
+            if (since > 0 && (unsigned long)entry.epoch < since) continue;
+            if (before > 0 && (unsigned long)entry.epoch >= before) continue;
+            
+            writeEntry(entry);
+            count++;
+            return true;
+        }
+        
+        json.endArray();
+        
+        // Sonraki sayfa için imleç (daha eski kayıt kalmadıysa null)
+        json.key("next");
+        if (exhausted) {
+            json.valueNull();
+        } else {
+            json.value((unsigned long)id);
+        }
+        json.field("latest", (unsigned long)newest);
+        json.field("boot", (unsigned long)logBootId);
+        json.endObject();
+        return false;
     }
     
-    long newBaud = server.arg("baud").toInt();
+private:
+    JsonWriter json;
+    bool started = false;
+    bool exhausted = true;
+    long count = 0;
+    
+    void writeEntry(const LogEntry& entry) {
+        char timestamp[24];
+        char message[192];
+        formatLogTimestamp(entry, timestamp, sizeof(timestamp));
+        formatLogMessage(entry, message, sizeof(message));
+        
+        json.beginObject();
+        json.field("id", (unsigned long)id);
+        json.field("t", (const char*)timestamp);
+        json.field("e", (unsigned long)entry.epoch);
+        json.field("l", logLevelToString((LogLevel)entry.level));
+        json.field("s", logSourceToString((LogSource)entry.source));
+        json.field("m", (const char*)message);
+        if (entry.repeatCount > 0) {
+            // Tekrar özeti: kaç kez tekrarlandı, ilk tekrar ne zaman
+            formatLogFirstTimestamp(entry, timestamp, sizeof(timestamp));
+            json.field("r", (unsigned)entry.repeatCount);
+            json.field("rf", (const char*)timestamp);
+        }
+        json.endObject();
+    }
+};
+
+// Filtreler: /api/logs?level=ERROR,WARN&source=UART&since=&before=&limit=&cursor=
+// arg(name) parametre değerini döner (yoksa boş) - istekten ya da batch alt isteğinden
+template <typename ArgFn>
+static LogQueryStream* newLogQuery(ArgFn arg) {
+    LogQueryStream* query = new LogQueryStream();
+    
+    String levels = arg("level");
+    int start = 0;
+    while (start < (int)levels.length()) {
+        int comma = levels.indexOf(',', start);
+        if (comma < 0) comma = levels.length();
+        int level = logLevelFromString(levels.substring(start, comma));
+        if (level >= 0) query->levelMask |= (1 << level);
+        start = comma + 1;
+    }
+    
+    // Kaynak filtresi: virgülle ayrılmış isimler -> bit maskesi
+    String sources = arg("source");
+    query->filterSource = sources.length() > 0;
+    start = 0;
+    while (start < (int)sources.length()) {
+        int comma = sources.indexOf(',', start);
+        if (comma < 0) comma = sources.length();
+        int source = logSourceFromString(sources.substring(start, comma));
+        if (source >= 0) query->sourceMask |= (1UL << source);
+        start = comma + 1;
+    }
     
-    if (!changeBaudRate(newBaud)) {
-        server.send(500, "text/plain", "Error");
+    query->since = strtoul(arg("since").c_str(), NULL, 10);
+    query->before = strtoul(arg("before").c_str(), NULL, 10);
+    
+    long limit = arg("limit").toInt();
+    if (limit <= 0) limit = 50;
+    if (limit > 200) limit = 200;
+    query->limit = limit;
+    
+    // İmleç: bu id'den daha eski kayıtlar döner (yoksa en yeniden başla)
+    query->newest = logSequence;
+    query->id = query->newest;
+    String cursorArg = arg("cursor");
+    if (cursorArg.length() > 0) {
+        uint32_t cursor = strtoul(cursorArg.c_str(), NULL, 10);
+        if (cursor < query->newest) query->id = cursor;
+    }
+    return query;
+}
+
+void handleGetLogsAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    server.send(200, "text/plain", "OK");
+    sendChunked(request, "application/json",
+                newLogQuery([request](const char* name) { return request->arg(name); }));
 }
 
-void handleGetLogsAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+void handleClearLogsAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    String json = "[";
-    int count = min(15, totalLogs);
+    clearLogs();
+    request->send(200, "text/plain", "OK");
+}
+
+// Sıra -> seviye adı (SUCCESS, INFO sırasında olduğu için listede yok)
+static const char* logRankToString(uint8_t rank) {
+    static const char* const names[] = {"ERROR", "WARN", "INFO", "DEBUG"};
+    return rank <= LOG_RANK_DEBUG ? names[rank] : "DEBUG";
+}
+
+// Kaynak başına log eşikleri
+static void writeLogLevelsJson(JsonWriter& json) {
+    json.beginObject();
+    json.field("compileLevel", logRankToString(LOG_COMPILE_LEVEL));
+    json.field("capacity", (unsigned long)getLogCapacity());
+    json.field("psram", isLogBufferInPsram());
+    json.key("sources");
+    json.beginObject();
+    for (int i = 0; i < LOG_SOURCE_COUNT; i++) {
+        json.field(logSourceToString((LogSource)i), logRankToString(logThresholds[i]));
+    }
+    json.endObject();
+    json.endObject();
+}
+
+void handleGetLogLevelsAPI(AsyncWebServerRequest* request) {
+    sendReadOnly(request, writeLogLevelsJson);
+}
+
+// Bir kaynağın (veya source=all ile hepsinin) eşiğini ve/veya halka
+// kapasitesini değiştir - reflash gerekmez
+void handlePostLogLevelsAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
+        return;
+    }
     
-    for (int i = 0; i < count; i++) {
-        int idx = (logIndex - 1 - i + 50) % 50;
-        if (logs[idx].message.length() > 0) {
-            if (i > 0) json += ",";
-            json += "{\"t\":\"" + logs[idx].timestamp + "\",";
-            json += "\"m\":\"" + logs[idx].message + "\",";
-            json += "\"l\":\"" + logLevelToString(logs[idx].level) + "\",";
-            json += "\"s\":\"" + logs[idx].source + "\"}";
+    if (request->hasArg("capacity")) {
+        if (!setLogCapacity(strtoul(request->arg("capacity").c_str(), NULL, 10))) {
+            request->send(400, "text/plain", "Invalid capacity");
+            return;
+        }
+        if (!request->hasArg("level")) {
+            request->send(200, "text/plain", "OK");
+            return;
         }
     }
-    json += "]";
     
-    server.send(200, "application/json", json);
+    int level = logLevelFromString(request->arg("level"));
+    if (level < 0 || level == SUCCESS) {
+        request->send(400, "text/plain", "Invalid level");
+        return;
+    }
+    
+    String sourceName = request->arg("source");
+    if (sourceName == "all") {
+        for (int i = 0; i < LOG_SOURCE_COUNT; i++) {
+            setLogThreshold((LogSource)i, (uint8_t)level);
+        }
+    } else {
+        int source = logSourceFromString(sourceName);
+        if (source < 0) {
+            request->send(400, "text/plain", "Invalid source");
+            return;
+        }
+        setLogThreshold((LogSource)source, (uint8_t)level);
+    }
+    
+    request->send(200, "text/plain", "OK");
 }
 
-void handleClearLogsAPI() {
-    if (!checkSession()) {
-        server.send(401, "text/plain", "Unauthorized");
+// Arşiv segmentlerini sırayla, her step()'te bir blok okuyarak aktarır
+class LogArchiveStream : public ChunkedSource {
+public:
+    LogArchiveStream(uint32_t first, uint32_t last) : segment(first), lastSegment(last) {}
+    
+protected:
+    bool step() override {
+        while (true) {
+            if (!file) {
+                if (segment > lastSegment) return false;
+                file = LittleFS.open(getLogSegmentPath(segment++), "r");
+                continue;  // Açılamadıysa bu arada döndürülmüş olabilir
+            }
+            
+            uint8_t buffer[512];
+            size_t n = file.read(buffer, sizeof(buffer));
+            if (n > 0) {
+                write(buffer, n);
+                return true;
+            }
+            file.close();
+            file = File();
+        }
+    }
+    
+private:
+    File file;
+    uint32_t segment;
+    uint32_t lastSegment;
+};
+
+// Kalıcı log arşivini (tüm segmentler, eskiden yeniye) indir
+void handleLogArchiveAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        request->send(401, "text/plain", "Unauthorized");
         return;
     }
     
-    clearLogs();
-    server.send(200, "text/plain", "OK");
+    // RAM tamponlarında bekleyen satırlar da arşive girsin
+    flushLogStorage();
+    LogStorageStats stats = getLogStorageStats();
+    
+    sendChunked(request, "text/plain", new LogArchiveStream(stats.firstSegment, stats.currentSegment),
+                200, "attachment; filename=\"teias_logs.txt\"");
 }
 
 // UART Test API Handler
-void handleUARTTestAPI() {
-    if (!checkSession()) {
-        server.send(401, "application/json", "{\"error\":\"Unauthorized\"}");
+void handleUARTTestAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        sendJsonError(request, 401, "Unauthorized");
         return;
     }
     
     // UART test fonksiyonu
-    bool result = testUARTConnection();
-    if (result) {
-        server.send(200, "application/json", "{\"success\":true,\"message\":\"UART connection successful\"}");
-    } else {
-        server.send(500, "application/json", "{\"success\":false,\"message\":\"UART connection failed\"}");
+    submitJobResponse(request, UART_JOB_TEST);
+}
+
+// UART iş durumu: /api/jobs/{id}. Biten işin sonucu bir kez teslim edilir.
+void handleGetJobAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        sendJsonError(request, 401, "Unauthorized");
+        return;
+    }
+    
+    const String& url = request->url();
+    int32_t id = url.substring(url.lastIndexOf('/') + 1).toInt();
+    
+    UartJobInfo job;
+    if (pollUartJob(id, job) == UART_JOB_FREE) {
+        sendJsonError(request, 404, "İş bulunamadı");
+        return;
     }
+    
+    JsonResponse* body = new JsonResponse();
+    writeUartJobJson(body->json, job);
+    sendJson(request, body);
 }
 
-// Web rotaları
-void setupWebRoutes() {
-    // Dosyaları belleğe yükle
-    loadFilesToMemory();
-    
-    // Ana sayfa
-    server.on("/", HTTP_GET, []() {
-        if (!checkSession()) { 
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
-            return;
+void handleHttpMetricsAPI(AsyncWebServerRequest* request) {
+    sendReadOnlySteps(request, writeHttpMetricsJson);
+}
+
+void handleWebSocketMetricsAPI(AsyncWebServerRequest* request) {
+    sendReadOnlySteps(request, writeWebSocketMetricsJson);
+}
+
+// /api/batch alt isteği olabilecek salt okunur rotalar (/api/logs ayrıca akışla)
+struct BatchRoute {
+    const char* path;
+    void (*write)(JsonWriter&);      // Tek parçalık gövde
+    JsonStepWriter steps;            // ya da parça parça üretilen gövde
+    bool config;         // Yapılandırma: istemcinin ETag'i güncelse gövdesiz 304
+};
+
+static const BatchRoute BATCH_ROUTES[] = {
+    {"/api/status",       writeStatusJson,          NULL,                       false},
+    {"/api/settings",     writeCachedSettingsJson,  NULL,                       true},
+    {"/api/ntp",          writeCachedNtpJson,       NULL,                       true},
+    {"/api/baudrate",     writeCachedBaudRateJson,  NULL,                       true},
+    {"/api/logs/levels",  writeLogLevelsJson,       NULL,                       false},
+    {"/api/metrics/http", NULL,                     writeHttpMetricsJson,       false},
+    {"/api/metrics/ws",   NULL,                     writeWebSocketMetricsJson,  false},
+};
+
+static int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// application/x-www-form-urlencoded çözümü: '+' boşluk, %XX bayt
+// (doğrudan isteklerde sunucunun yaptığı gibi)
+static String urlDecode(const char* text, size_t length) {
+    String decoded;
+    decoded.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c == '+') {
+            c = ' ';
+        } else if (c == '%' && i + 2 < length) {
+            int high = hexDigit(text[i + 1]);
+            int low = high < 0 ? -1 : hexDigit(text[i + 2]);
+            if (low >= 0) {
+                c = (char)((high << 4) | low);
+                i += 2;
+            }
         }
-        serveCachedFile("/index.html", "text/html");
-    });
-    
-    // Login
-    server.on("/login", HTTP_GET, []() {
-        if (checkSession()) {
-            server.sendHeader("Location", "/");
-            server.send(302, "text/plain", "Already logged in");
-            return;
+        decoded += c;
+    }
+    return decoded;
+}
+
+// Alt isteğin sorgu dizesinden parametre ("a=1&b=2" içinden name); ad ve
+// değer URL çözülür
+static String queryArg(const String& query, const char* name) {
+    int start = 0;
+    while (start < (int)query.length()) {
+        int end = query.indexOf('&', start);
+        if (end < 0) end = query.length();
+        int eq = query.indexOf('=', start);
+        if (eq < 0 || eq > end) eq = end;
+        if (urlDecode(query.c_str() + start, eq - start) == name) {
+            return eq < end ? urlDecode(query.c_str() + eq + 1, end - eq - 1) : String();
         }
-        serveCachedFile("/login.html", "text/html");
-    });
-    
-    // Statik dosyalar - Cache'ten
-    server.on("/style.css", HTTP_GET, []() {
-        serveCachedFile("/style.css", "text/css");
-    });
-    
-    server.on("/script.js", HTTP_GET, []() {
-        serveCachedFile("/script.js", "application/javascript");
-    });
-    
-    // Diğer sayfalar
-    server.on("/account", HTTP_GET, []() {
-        if (!checkSession()) {
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
-            return;
+        start = end + 1;
+    }
+    return String();
+}
+
+// {"responses":[{"path":"/api/status","status":200,"body":{...}},
+//                {"path":"/api/ntp","status":200,"etag":"...","body":{...}}, ...]}
+// Yapılandırma alt isteğinde istemcinin o yol için sakladığı ETag güncelse
+// gövdesiz 304 döner; ETag'ler yol başına karşılaştırılır.
+// Her step() bir alt yanıt yazar; /api/logs ve parça parça üretilen gövdeler
+// kendi akışlarından aktarılır. Gövdeler gönderim anında üretilir.
+class BatchStream : public ChunkedSource {
+public:
+    String paths[BATCH_MAX_REQUESTS];
+    String etags[BATCH_MAX_REQUESTS];   // İstemcinin o yol için sakladığı ETag (varsa)
+    uint8_t count = 0;
+    
+    BatchStream() : json(*this) {}
+    ~BatchStream() { delete inner; }
+    
+protected:
+    bool step() override {
+        if (inner != NULL) {
+            uint8_t buffer[256];
+            size_t n = inner->fill(buffer, sizeof(buffer));
+            if (n > 0) {
+                write(buffer, n);
+                return true;
+            }
+            delete inner;
+            inner = NULL;
+            json.endObject();
+            return true;
         }
-        serveCachedFile("/account.html", "text/html");
-    });
-    
-    server.on("/fault", HTTP_GET, []() {
-        if (!checkSession()) {
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
-            return;
+        
+        if (!started) {
+            configTag = configETag();
+            json.beginObject();
+            json.key("responses");
+            json.beginArray();
+            started = true;
+            return true;
         }
-        serveCachedFile("/fault.html", "text/html");
-    });
-    
-    server.on("/ntp", HTTP_GET, []() {
-        if (!checkSession()) {
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
-            return;
+        
+        if (index >= count) {
+            json.endArray();
+            json.endObject();
+            return false;
         }
-        serveCachedFile("/ntp.html", "text/html");
-    });
-    
-    server.on("/baudrate", HTTP_GET, []() {
-        if (!checkSession()) {
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
-            return;
+        
+        uint8_t current = index++;
+        const String& path = paths[current];
+        int q = path.indexOf('?');
+        String route = q < 0 ? path : path.substring(0, q);
+        String query = q < 0 ? String() : path.substring(q + 1);
+        
+        json.beginObject();
+        json.field("path", path);
+        
+        if (route == "/api/logs") {
+            return beginInner(newLogQuery([&query](const char* name) { return queryArg(query, name); }));
+        }
+        
+        for (size_t i = 0; i < sizeof(BATCH_ROUTES) / sizeof(BATCH_ROUTES[0]); i++) {
+            if (route == BATCH_ROUTES[i].path) {
+                if (BATCH_ROUTES[i].config) {
+                    if (etags[current] == configTag) {
+                        json.field("status", 304);
+                        json.endObject();
+                        return true;
+                    }
+                    json.field("etag", configTag);
+                }
+                if (BATCH_ROUTES[i].steps != NULL) {
+                    return beginInner(new JsonStepResponse(BATCH_ROUTES[i].steps));
+                }
+                json.field("status", 200);
+                json.key("body");
+                BATCH_ROUTES[i].write(json);
+                json.endObject();
+                return true;
+            }
         }
-        serveCachedFile("/baudrate.html", "text/html");
-    });
+        
+        json.field("status", 404);
+        json.key("body");
+        json.beginObject();
+        json.field("error", "Desteklenmeyen alt istek");
+        json.endObject();
+        json.endObject();
+        return true;
+    }
+    
+private:
+    JsonWriter json;
+    ChunkedSource* inner = NULL;   // Gövdesi aktarılmakta olan alt akış
+    String configTag;
+    bool started = false;
+    uint8_t index = 0;
+    
+    // Alt akışın gövdesini sonraki step()'lerde aktar
+    bool beginInner(ChunkedSource* source) {
+        inner = source;
+        inner->detachMetrics();   // Baytları batch akışı sayar
+        json.field("status", 200);
+        json.key("body");
+        json.beginRawValue();
+        return true;
+    }
+};
+
+// Sayfa açılışı için toplu sorgu: path=/api/status&path=/api/ntp&etag=...&path=/api/logs?limit=20 ...
+// Tek oturum kontrolü, tek TCP değişimi, tek akışlı JSON yanıtı
+void handleBatchAPI(AsyncWebServerRequest* request) {
+    if (!checkSession(request)) {
+        sendJsonError(request, 401, "Unauthorized");
+        return;
+    }
     
-    server.on("/log", HTTP_GET, []() {
-        if (!checkSession()) {
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
+    BatchStream* batch = new BatchStream();
+    size_t params = request->params();
+    for (size_t i = 0; i < params; i++) {
+        const AsyncWebParameter* param = request->getParam(i);
+        if (!param->isPost()) continue;
+        // etag kendinden önceki path'e aittir
+        if (param->name() == "etag" && batch->count > 0) {
+            batch->etags[batch->count - 1] = param->value();
+            continue;
+        }
+        if (param->name() != "path") continue;
+        if (batch->count >= BATCH_MAX_REQUESTS) {
+            delete batch;
+            sendJsonError(request, 400, "Çok fazla alt istek");
             return;
         }
-        serveCachedFile("/log.html", "text/html");
-    });
+        batch->paths[batch->count++] = param->value();
+    }
+    
+    if (batch->count == 0) {
+        delete batch;
+        sendJsonError(request, 400, "Alt istek yok");
+        return;
+    }
+    
+    sendChunked(request, "application/json", batch);
+}
+
+bool checkRateLimit(AsyncWebServerRequest* request, RateClass rateClass) {
+    uint32_t retryAfter = 0;
+    if (takeRateToken((uint32_t)request->client()->remoteIP(), rateClass, retryAfter)) {
+        return true;
+    }
+    
+    AsyncWebServerResponse* response = request->beginResponse(429, "text/plain", "Too Many Requests");
+    response->addHeader("Retry-After", String(retryAfter));
+    request->send(response);
+    return false;
+}
+
+// Handler'ı ölçümle sar: süre (esp_timer), durum kodu; gövde baytını yanıt kaynağı ekler.
+// Süre, yanıtın tamamı gönderilip bağlantı kapanınca (ya da istemci kopunca)
+// kaydedilir - akışlı yanıtlarda gönderim de ölçülür. Handler'lar onDisconnect
+// kullanmaz; kullanırsa buradaki kayıt onu ezer.
+static ArRequestHandlerFunction measured(HttpRouteMetrics* metrics, ArRequestHandlerFunction handler) {
+    return [metrics, handler](AsyncWebServerRequest* request) {
+        int64_t start = beginHttpRequest(metrics);
+        handler(request);
+        endHttpHandler();
+        
+        const AsyncWebServerResponse* response = request->getResponse();
+        int code = response != NULL ? response->code() : 0;
+        request->onDisconnect([metrics, start, code]() {
+            endHttpRequest(metrics, start, code);
+        });
+    };
+}
+
+// İstemci IP'sinin kovasından token al, yoksa handler çalışmaz (429)
+static ArRequestHandlerFunction limited(RateClass rateClass, ArRequestHandlerFunction handler) {
+    return [rateClass, handler](AsyncWebServerRequest* request) {
+        if (checkRateLimit(request, rateClass)) handler(request);
+    };
+}
+
+// Ölçülen ve hız sınırlı rota kaydı - tüm rotalar buradan geçer (/api/metrics/http)
+static void route(const char* uri, WebRequestMethodComposite method, ArRequestHandlerFunction handler,
+                  RateClass rateClass = RATE_API, ArUploadHandlerFunction upload = nullptr) {
+    server.on(uri, method, measured(registerHttpRouteMetrics(uri, method), limited(rateClass, handler)), upload);
+}
+
+// Web rotaları
+void setupWebRoutes() {
+    configEpoch = esp_random();
     
     // Parola değiştirme sayfası
-    server.on("/change-password", HTTP_GET, []() {
-        if (!checkSession()) {
-            server.sendHeader("Location", "/login");
-            server.send(302, "text/plain", "Login required");
+    route("/change-password", HTTP_GET, [](AsyncWebServerRequest* request) {
+        if (!checkSession(request)) {
+            request->redirect("/login");
             return;
         }
         if (mustChangePassword()) {
-            handlePasswordChangePage();
+            handlePasswordChangePage(request);
         } else {
-            server.sendHeader("Location", "/");
-            server.send(302, "text/plain", "Password change not required");
+            request->redirect("/");
         }
-    });
+    }, RATE_STATIC);
     
     // Auth endpoints
-    server.on("/login", HTTP_POST, handleUserLogin);
-    server.on("/logout", HTTP_GET, handleUserLogout);
+    route("/login", HTTP_POST, handleUserLogin);
+    route("/logout", HTTP_GET, handleUserLogout);
+    route("/api/ws-ticket", HTTP_POST, handleWsTicket);
     
     // API endpoints
-    server.on("/api/status", HTTP_GET, handleStatusAPI);
-    server.on("/api/settings", HTTP_GET, handleGetSettingsAPI);
-    server.on("/api/settings", HTTP_POST, handlePostSettingsAPI);
-    server.on("/api/faults/first", HTTP_POST, []() { handleFaultRequest(true); });
-    server.on("/api/faults/next", HTTP_POST, []() { handleFaultRequest(false); });
-    server.on("/api/faults/refresh", HTTP_POST, []() { handleFaultRequest(false); });
-    server.on("/api/ntp", HTTP_GET, handleGetNtpAPI);
-    server.on("/api/ntp", HTTP_POST, handlePostNtpAPI);
-    server.on("/api/baudrate", HTTP_GET, handleGetBaudRateAPI);
-    server.on("/api/baudrate", HTTP_POST, handlePostBaudRateAPI);
-    server.on("/api/logs", HTTP_GET, handleGetLogsAPI);
-    server.on("/api/logs/clear", HTTP_POST, handleClearLogsAPI);
+    route("/api/status", HTTP_GET, handleStatusAPI);
+    route("/api/settings", HTTP_GET, handleGetSettingsAPI);
+    route("/api/settings", HTTP_POST, handlePostSettingsAPI);
+    route("/api/faults/first", HTTP_POST, [](AsyncWebServerRequest* request) { handleFaultRequest(request, true); }, RATE_UART);
+    route("/api/faults/next", HTTP_POST, [](AsyncWebServerRequest* request) { handleFaultRequest(request, false); }, RATE_UART);
+    route("/api/faults/refresh", HTTP_POST, [](AsyncWebServerRequest* request) { handleFaultRequest(request, false); }, RATE_UART);
+    route("/api/ntp", HTTP_GET, handleGetNtpAPI);
+    route("/api/ntp", HTTP_POST, handlePostNtpAPI, RATE_UART);
+    route("/api/baudrate", HTTP_GET, handleGetBaudRateAPI);
+    route("/api/baudrate", HTTP_POST, handlePostBaudRateAPI, RATE_UART);
+    // "/api/logs" alt yolları da eşler - alt yollar ondan önce kaydedilmeli
+    route("/api/logs/clear", HTTP_POST, handleClearLogsAPI);
+    route("/api/logs/download", HTTP_GET, handleLogArchiveAPI);
+    route("/api/logs/levels", HTTP_GET, handleGetLogLevelsAPI);
+    route("/api/logs/levels", HTTP_POST, handlePostLogLevelsAPI);
+    route("/api/logs", HTTP_GET, handleGetLogsAPI);
     
     // Yeni API endpoints
-    server.on("/api/backup/download", HTTP_GET, handleBackupDownload);
-    server.on("/api/backup/upload", HTTP_POST, handleBackupUpload);
-    server.on("/api/change-password", HTTP_POST, handlePasswordChangeAPI);
-    server.on("/api/uart/test", HTTP_POST, handleUARTTestAPI);
-    
-    // 404
-    server.onNotFound([]() {
-        server.send(404, "text/plain", "404: Not Found");
-    });
-    
-    // Server optimizasyonları
-    server.enableCORS(false);  // CORS kapat
-    server.enableDelay(false); // Delay kapat
+    route("/api/backup/download", HTTP_GET, handleBackupDownload);
+    route("/api/backup/upload", HTTP_POST, handleBackupUpload, RATE_API, handleBackupUploadData);
+    route("/api/change-password", HTTP_POST, handlePasswordChangeAPI);
+    route("/api/uart/test", HTTP_POST, handleUARTTestAPI, RATE_UART);
+    route("/api/jobs", HTTP_GET, handleGetJobAPI);   // /api/jobs/{id}
+    route("/api/metrics/http", HTTP_GET, handleHttpMetricsAPI);
+    route("/api/metrics/ws", HTTP_GET, handleWebSocketMetricsAPI);
+    route("/api/batch", HTTP_POST, handleBatchAPI);
+    
+    // Sayfalar ve statik varlıklar (oturum kuralları tabloda), diğerleri 404
+    server.onNotFound(measured(registerHttpRouteMetrics("static", HTTP_ANY),
+                               limited(RATE_STATIC, handleStaticRequest)));
     
     server.begin();
     
-    addLog("✅ Web sunucu başlatıldı", SUCCESS, "WEB");
+    LOGS(LOG_SRC_WEB, LT_WEB_STARTED);
 }
\ No newline at end of file
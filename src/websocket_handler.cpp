@@ -2,40 +2,486 @@
 #include "log_system.h"
 #include "settings.h"
 #include "auth_system.h"
+#include "uart_jobs.h"
+#include "status_snapshot.h"
 #include <WebSocketsServer.h>
 #include <ArduinoJson.h>
+#include <lwip/sockets.h>
 
-// External functions
-extern String getCurrentDateTime();
-extern String getUptime();
-extern bool isTimeSynced();
+// Log akışı ayarları
+#define WS_LOG_BATCH_SIZE     20   // Tek "logs" frame'indeki en fazla kayıt
+#define WS_LOG_PUSH_INTERVAL  250  // Canlı kayıtlar bu aralıkla toplu gönderilir (ms)
+
+// Oturumu kapanan clientlar en geç bu aralıkla bulunur (çıkış/endAllSessions
+// anında, süre dolması bu kontrolde yakalanır)
+#define WS_SESSION_CHECK_INTERVAL 5000
+
+// Gönderim kuyruğu ayarları
+#define WS_QUEUE_DEPTH        8    // Client başına bekleyen en fazla mesaj
+#define WS_DRAIN_PER_CLIENT   2    // loop() turu başına client başına en fazla gönderim
+
+// lwIP soketi gönderim tamponunda TCP_SNDLOWAT byte'tan az yer kalınca
+// yazılamaz işaretler; select() yazılabilir diyorsa en az bu kadar yer vardır.
+// Başlığıyla birlikte bu sınırı aşmayan frame tek seferde, bloklamadan yazılır.
+// Bu yüzden her mesaj bu boyutla sınırlıdır (log partileri bölünür).
+#define WS_FRAME_HEADER_MAX   10
+#define WS_FRAME_MAX          (TCP_SNDLOWAT - WS_FRAME_HEADER_MAX)
+
+// Soket yazılabilir mi sorgusu için istemci tablosuna erişim. sendTXT
+// gönderim tamponu doluyken bloklar; kuyruk sadece yer varken boşaltılır.
+class QueuedWebSocketsServer : public WebSocketsServer {
+public:
+    using WebSocketsServer::WebSocketsServer;
+    
+    bool canWrite(uint8_t num) {
+        if (num >= WS_MAX_CLIENTS || _clients[num].tcp == NULL || !_clients[num].tcp->connected()) {
+            return false;
+        }
+        int fd = _clients[num].tcp->fd();
+        if (fd < 0) return false;
+        
+        fd_set writable;
+        FD_ZERO(&writable);
+        FD_SET(fd, &writable);
+        struct timeval noWait = {0, 0};
+        return select(fd + 1, NULL, &writable, NULL, &noWait) > 0;
+    }
+};
 
 // WebSocket server instance
-WebSocketsServer webSocket(WEBSOCKET_PORT);
+QueuedWebSocketsServer webSocket(WEBSOCKET_PORT);
+
+// Mesaj türleri - kuyruk doluyken her tür kendi kuralına göre ele alınır
+enum WsTopic : uint8_t {
+    WS_TOPIC_CONTROL,   // auth, pong, iş sonucu, komut yanıtları
+    WS_TOPIC_LOG,       // Anlık log bildirimi (broadcastLog)
+    WS_TOPIC_LOGS,      // Seq'li log akışı - sadece kuyrukta yer varken üretilir
+    WS_TOPIC_FAULT,     // Arıza verisi
+    WS_TOPIC_COUNT
+};
+
+enum WsQueuePolicy : uint8_t {
+    WS_KEEP,            // Düşürülmez; yer açmak için düşürülebilir bir mesaj atılır
+    WS_DROP_NEW         // Kuyruk doluysa yeni mesaj düşürülür
+};
+
+// Durum kuyruğa girmez: gönderim anında en güncel görüntüden üretilir
+// (bkz. sendStatusUpdate), bekleyen eski durum kendiliğinden birleşir.
+static const WsQueuePolicy WS_TOPIC_POLICY[WS_TOPIC_COUNT] = {
+    WS_KEEP,        // CONTROL
+    WS_DROP_NEW,    // LOG
+    WS_KEEP,        // LOGS
+    WS_KEEP         // FAULT
+};
+
+// Bir kez serileştirilen, paylaşımlı mesaj. Her kuyruk bir referans tutar;
+// son referans bırakılınca serbest kalır. Sadece loop() task'ında kullanılır.
+struct WsMessage {
+    uint8_t refs;
+    WsTopic topic;
+    bool binary;             // MessagePack (sendBIN), değilse JSON metni
+    size_t length;
+    char data[1];
+};
+
+// WS_FRAME_MAX'ı aşan mesaj üretilmez - gönderimi loop()'u bloklayabilirdi
+static WsMessage* newWsMessage(WsTopic topic, size_t length) {
+    if (length > WS_FRAME_MAX) {
+        LOGW(LOG_SRC_WS, LT_WS_FRAME_TOO_LARGE, length, WS_FRAME_MAX);
+        return NULL;
+    }
+    WsMessage* msg = (WsMessage*)malloc(sizeof(WsMessage) + length);
+    if (msg == NULL) return NULL;
+    msg->refs = 1;
+    msg->topic = topic;
+    msg->binary = false;
+    msg->length = length;
+    msg->data[length] = '\0';
+    return msg;
+}
+
+static WsMessage* newWsMessage(WsTopic topic, const char* data, size_t length) {
+    WsMessage* msg = newWsMessage(topic, length);
+    if (msg != NULL) memcpy(msg->data, data, length);
+    return msg;
+}
+
+// Belge doğrudan mesaj tamponuna yazılır, ara String yok
+static WsMessage* newWsMessage(WsTopic topic, const JsonDocument& doc, bool binary = false) {
+    if (binary) {
+        WsMessage* msg = newWsMessage(topic, measureMsgPack(doc));
+        if (msg == NULL) return NULL;
+        msg->binary = true;
+        serializeMsgPack(doc, msg->data, msg->length);
+        return msg;
+    }
+    WsMessage* msg = newWsMessage(topic, measureJson(doc));
+    if (msg != NULL) serializeJson(doc, msg->data, msg->length + 1);
+    return msg;
+}
+
+static void releaseWsMessage(WsMessage* msg) {
+    if (msg != NULL && --msg->refs == 0) {
+        free(msg);
+    }
+}
 
 // Client authentication tracking
 struct WSClient {
     bool authenticated;
     unsigned long lastPing;
-    String sessionId;
+    uint8_t sessionToken[SESSION_TOKEN_BYTES];
+    bool hasSession;         // Bağlantı URL'sindeki bilet bir oturuma çözüldü
+    bool logSubscribed;      // logs_since ile canlı log akışına abone mi
+    uint32_t logSeq;         // Client'a gönderilecek sıradaki log seq'i
+    
+    // Gönderim kuyruğu (queue[0] en eski)
+    WsMessage* queue[WS_QUEUE_DEPTH];
+    uint8_t queueCount;
+    uint8_t queuePeak;       // Görülen en yüksek derinlik
+    bool overflowed;         // Düşürülemeyen mesaja yer yok - bağlantı kesilecek
+    uint32_t sent;
+    uint32_t dropped;
+    uint32_t coalesced;      // Gönderilemeden yenisi gelen durumlar
+    bool binary;             // auth'ta MessagePack istedi (durum/log/arıza olayları)
+    
+    // Client'ın elindeki durum: son gönderilen görüntünün versiyonu ve alan CRC'leri
+    bool statusDue;          // Gönderilecek yeni durum var
+    bool statusResync;       // Sıradaki gönderim tam görüntü olmalı
+    uint32_t statusVersion;
+    uint8_t statusFieldCount;
+    uint32_t statusHash[STATUS_FIELD_MAX];
 };
 
-WSClient wsClients[5]; // Max 5 concurrent WebSocket connections
+WSClient wsClients[WS_MAX_CLIENTS];
+
+// Bekleyen mesajları bırak (bağlantı kapanınca)
+static void clearClientQueue(WSClient& client) {
+    for (uint8_t i = 0; i < client.queueCount; i++) {
+        releaseWsMessage(client.queue[i]);
+    }
+    client.queueCount = 0;
+    client.overflowed = false;
+}
+
+static void removeQueued(WSClient& client, uint8_t index) {
+    releaseWsMessage(client.queue[index]);
+    client.queueCount--;
+    for (uint8_t i = index; i < client.queueCount; i++) {
+        client.queue[i] = client.queue[i + 1];
+    }
+}
+
+// Mesajı client kuyruğuna ekle - hiçbir zaman beklemez
+static bool enqueueWsMessage(uint8_t num, WsMessage* msg) {
+    if (msg == NULL || num >= WS_MAX_CLIENTS) return false;
+    WSClient& client = wsClients[num];
+    WsQueuePolicy policy = WS_TOPIC_POLICY[msg->topic];
+    
+    if (client.queueCount == WS_QUEUE_DEPTH) {
+        if (policy != WS_KEEP) {
+            client.dropped++;
+            return false;
+        }
+        
+        // En eski düşürülebilir mesajı at; hiç yoksa client takılmıştır
+        uint8_t victim = WS_QUEUE_DEPTH;
+        for (uint8_t i = 0; i < client.queueCount && victim == WS_QUEUE_DEPTH; i++) {
+            if (WS_TOPIC_POLICY[client.queue[i]->topic] != WS_KEEP) victim = i;
+        }
+        client.dropped++;
+        if (victim == WS_QUEUE_DEPTH) {
+            client.overflowed = true;
+            return false;
+        }
+        removeQueued(client, victim);
+    }
+    
+    client.queue[client.queueCount++] = msg;
+    msg->refs++;
+    if (client.queueCount > client.queuePeak) client.queuePeak = client.queueCount;
+    return true;
+}
+
+// Tek mesajı tüm authenticated clientların kuyruğuna ekle ve bırak
+static void broadcastWsMessage(WsMessage* msg) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (wsClients[i].authenticated) {
+            enqueueWsMessage(i, msg);
+        }
+    }
+    releaseWsMessage(msg);
+}
+
+// Belgeyi clientların kodlamasına göre en fazla iki kez (JSON ve
+// MessagePack) serileştir, aynı kodlamadaki clientlar tamponu paylaşır
+static void broadcastWsDocument(WsTopic topic, const JsonDocument& doc) {
+    WsMessage* text = NULL;
+    WsMessage* packed = NULL;
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        if (!wsClients[i].authenticated) continue;
+        WsMessage*& msg = wsClients[i].binary ? packed : text;
+        if (msg == NULL) msg = newWsMessage(topic, doc, wsClients[i].binary);
+        enqueueWsMessage(i, msg);
+    }
+    releaseWsMessage(text);
+    releaseWsMessage(packed);
+}
+
+static void sendWsMessage(uint8_t num, WsMessage* msg) {
+    enqueueWsMessage(num, msg);
+    releaseWsMessage(msg);
+}
+
+static void sendWsJson(uint8_t num, const JsonDocument& doc) {
+    sendWsMessage(num, newWsMessage(WS_TOPIC_CONTROL, doc));
+}
+
+// Durum yaması: {"type":"status_patch","base":B,"version":V,"set":{değişen alanlar}}.
+// base, client'ın elindeki versiyondur; uymazsa client get_status ile tam
+// görüntü ister. Her iki kodlamada da yama, görüntüdeki alan parçalarının
+// kopyasıdır - client başına serileştirme yapılmaz.
+static uint8_t statusPatch[STATUS_SNAPSHOT_MAX + 64];
+static_assert(sizeof(statusPatch) <= WS_FRAME_MAX, "Durum frame'i tek gönderime sığmalı");
+
+// Client'ın elindeki görüntüden bu yana değişen alanlarla yamayı yaz;
+// değişen alan yoksa 0 döner
+static size_t writeStatusPatch(const WSClient& client, const StatusSnapshot* snapshot) {
+    size_t length = snprintf((char*)statusPatch, sizeof(statusPatch),
+                             "{\"type\":\"status_patch\",\"base\":%lu,\"version\":%lu,\"set\":{",
+                             (unsigned long)client.statusVersion, (unsigned long)snapshot->version);
+    bool changed = false;
+    for (uint8_t f = 0; f < snapshot->fieldCount; f++) {
+        const StatusField& field = snapshot->fields[f];
+        if (field.hash == client.statusHash[f]) continue;
+        if (changed) statusPatch[length++] = ',';
+        memcpy(statusPatch + length, snapshot->json + field.offset, field.length);
+        length += field.length;
+        changed = true;
+    }
+    if (!changed) return 0;
+    statusPatch[length++] = '}';
+    statusPatch[length++] = '}';
+    return length;
+}
+
+static size_t packStatusKey(size_t length, const char* key) {
+    size_t keyLength = strlen(key);
+    statusPatch[length++] = 0xa0 | keyLength;
+    memcpy(statusPatch + length, key, keyLength);
+    return length + keyLength;
+}
+
+static size_t packStatusVersion(size_t length, uint32_t version) {
+    statusPatch[length++] = 0xce;
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        statusPatch[length++] = version >> shift;
+    }
+    return length;
+}
+
+// Aynı yamanın MessagePack hali; değişen alanlar görüntünün packed
+// tamponundaki anahtar+değer parçalarından kopyalanır
+static size_t writeStatusPatchPacked(const WSClient& client, const StatusSnapshot* snapshot) {
+    uint16_t changed = 0;
+    for (uint8_t f = 0; f < snapshot->fieldCount; f++) {
+        if (snapshot->fields[f].hash != client.statusHash[f]) changed++;
+    }
+    if (changed == 0) return 0;
+    
+    size_t length = 0;
+    statusPatch[length++] = 0x84;   // 4 elemanlı map
+    length = packStatusKey(length, "type");
+    length = packStatusKey(length, "status_patch");
+    length = packStatusKey(length, "base");
+    length = packStatusVersion(length, client.statusVersion);
+    length = packStatusKey(length, "version");
+    length = packStatusVersion(length, snapshot->version);
+    length = packStatusKey(length, "set");
+    statusPatch[length++] = 0xde;   // map16
+    statusPatch[length++] = changed >> 8;
+    statusPatch[length++] = changed & 0xFF;
+    
+    for (uint8_t f = 0; f < snapshot->fieldCount; f++) {
+        const StatusField& field = snapshot->fields[f];
+        if (field.hash == client.statusHash[f]) continue;
+        memcpy(statusPatch + length, snapshot->packed + field.packedOffset, field.packedLength);
+        length += field.packedLength;
+    }
+    return length;
+}
+
+// Client'a durumu gönder: ilk seferde (veya resync'te) tam görüntü, sonra
+// sadece değişen alanlar. Hiçbir alan değişmediyse client eski versiyonda kalır.
+static void sendStatusUpdate(uint8_t num) {
+    WSClient& client = wsClients[num];
+    client.statusDue = false;
+    
+    const StatusSnapshot* snapshot = acquireStatusSnapshot();
+    bool full = client.statusResync || client.statusFieldCount != snapshot->fieldCount;
+    size_t patchLength = 0;
+    
+    if (full) {
+        if (client.binary) {
+            webSocket.sendBIN(num, snapshot->packed, snapshot->packedLength);
+        } else {
+            webSocket.sendTXT(num, snapshot->json, snapshot->length);
+        }
+    } else if (client.statusVersion != snapshot->version) {
+        if (client.binary) {
+            patchLength = writeStatusPatchPacked(client, snapshot);
+            if (patchLength > 0) webSocket.sendBIN(num, statusPatch, patchLength);
+        } else {
+            patchLength = writeStatusPatch(client, snapshot);
+            if (patchLength > 0) webSocket.sendTXT(num, (const char*)statusPatch, patchLength);
+        }
+    }
+    
+    if (full || patchLength > 0) {
+        client.statusResync = false;
+        client.statusVersion = snapshot->version;
+        client.statusFieldCount = snapshot->fieldCount;
+        for (uint8_t f = 0; f < snapshot->fieldCount; f++) {
+            client.statusHash[f] = snapshot->fields[f].hash;
+        }
+        client.sent++;
+    }
+    releaseStatusSnapshot(snapshot);
+}
+
+// Kuyrukları boşalt: soket yazılabilir değilse o client atlanır, yavaş
+// bir client diğerlerini ve loop()'u bekletmez. Durum, kuyruktaki
+// mesajlardan sonra kalan gönderim hakkıyla gider.
+static void drainWsQueues() {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+        WSClient& client = wsClients[i];
+        
+        if (client.overflowed) {
+            LOGW(LOG_SRC_WS, LT_WS_CLIENT_OVERFLOW, i, client.dropped);
+            webSocket.disconnect(i);
+            clearClientQueue(client);
+            client.authenticated = false;
+            continue;
+        }
+        
+        uint8_t n = 0;
+        for (; n < WS_DRAIN_PER_CLIENT && client.queueCount > 0; n++) {
+            if (!webSocket.canWrite(i)) break;
+            WsMessage* msg = client.queue[0];
+            if (msg->binary) {
+                webSocket.sendBIN(i, (const uint8_t*)msg->data, msg->length);
+            } else {
+                webSocket.sendTXT(i, msg->data, msg->length);
+            }
+            removeQueued(client, 0);
+            client.sent++;
+        }
+        
+        if (client.statusDue && client.authenticated && n < WS_DRAIN_PER_CLIENT &&
+            client.queueCount == 0 && webSocket.canWrite(i)) {
+            sendStatusUpdate(i);
+        }
+    }
+}
+
+// El sıkışmada tarayıcı HTTP oturum çerezini (port farkı önemsiz) gönderir;
+// geçerli oturumu olmayan bağlantı 400 ile reddedilir
+static const char* WS_MANDATORY_HEADERS[] = {"Cookie"};
+
+static bool validateWsHeader(String headerName, String headerValue) {
+    if (headerName.equalsIgnoreCase("Cookie")) {
+        return checkSessionCookie(headerValue);
+    }
+    return true;
+}
 
 // WebSocket başlatma
 void initWebSocket() {
     // WebSocket server'ı başlat
+    webSocket.onValidateHttpHeader(validateWsHeader, WS_MANDATORY_HEADERS, 1);
     webSocket.begin();
     webSocket.onEvent(webSocketEvent);
     
     // Client array'i temizle
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
         wsClients[i].authenticated = false;
         wsClients[i].lastPing = 0;
-        wsClients[i].sessionId = "";
+        wsClients[i].hasSession = false;
+        wsClients[i].logSubscribed = false;
+        wsClients[i].logSeq = 0;
+        wsClients[i].queueCount = 0;
+        wsClients[i].queuePeak = 0;
+        wsClients[i].overflowed = false;
+        wsClients[i].sent = 0;
+        wsClients[i].dropped = 0;
+        wsClients[i].coalesced = 0;
+        wsClients[i].statusDue = false;
+        wsClients[i].statusResync = true;
+        wsClients[i].statusVersion = 0;
+        wsClients[i].statusFieldCount = 0;
+        wsClients[i].binary = false;
     }
     
-    addLog("✅ WebSocket server başlatıldı (Port " + String(WEBSOCKET_PORT) + ")", SUCCESS, "WS");
+    LOGS(LOG_SRC_WS, LT_WS_STARTED, WEBSOCKET_PORT);
+}
+
+// from'dan itibaren en fazla maxCount kaydı tek "logs" frame'i olarak gönder.
+// Halkadan düşmüş kayıtlar atlanır ("gap"). Gönderilenden sonraki seq'i döner.
+static uint32_t sendLogBatch(uint8_t num, uint32_t from, uint32_t maxCount, bool reset) {
+    uint32_t newest = logSequence;
+    uint32_t oldest = getOldestLogId();
+    bool gap = from < oldest;
+    if (gap) from = oldest;
+    
+    JsonDocument doc;
+    doc["type"] = "logs";
+    if (reset) doc["reset"] = true;  // Client'ın seq'i başka bir açılıştan kalma
+    if (gap) doc["gap"] = true;
+    JsonArray entries = doc["entries"].to<JsonArray>();
+    
+    LogEntry entry;
+    char timestamp[24];
+    char message[192];
+    uint32_t seq = from;
+    uint32_t count = 0;
+    
+    while (seq < newest && count < maxCount) {
+        if (getLogEntry(seq, entry)) {
+            formatLogTimestamp(entry, timestamp, sizeof(timestamp));
+            formatLogMessage(entry, message, sizeof(message));
+            
+            JsonObject e = entries.add<JsonObject>();
+            e["seq"] = seq;
+            e["t"] = timestamp;
+            e["l"] = logLevelToString((LogLevel)entry.level);
+            e["s"] = logSourceToString((LogSource)entry.source);
+            e["m"] = message;
+            if (entry.repeatCount > 0) {
+                formatLogFirstTimestamp(entry, timestamp, sizeof(timestamp));
+                e["r"] = entry.repeatCount;
+                e["rf"] = timestamp;
+            }
+            count++;
+        }
+        seq++;
+    }
+    
+    doc["next"] = seq;
+    doc["latest"] = newest;
+    doc["boot"] = logBootId;
+    
+    // Frame tek gönderime sığana kadar sondan kayıt çıkar; çıkanlar
+    // sıradaki partiye kalır
+    bool binary = wsClients[num].binary;
+    while (entries.size() > 1 && (binary ? measureMsgPack(doc) : measureJson(doc)) > WS_FRAME_MAX) {
+        size_t last = entries.size() - 1;
+        seq = entries[last]["seq"].as<uint32_t>();
+        entries.remove(last);
+        doc["next"] = seq;
+    }
+    
+    sendWsMessage(num, newWsMessage(WS_TOPIC_LOGS, doc, binary));
+    return seq;
 }
 
 // WebSocket event handler
@@ -43,23 +489,40 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
     switch(type) {
         case WStype_DISCONNECTED: {
             wsClients[num].authenticated = false;
-            wsClients[num].sessionId = "";
-            addLog("WebSocket client #" + String(num) + " bağlantısı kesildi", INFO, "WS");
+            wsClients[num].hasSession = false;
+            wsClients[num].logSubscribed = false;
+            clearClientQueue(wsClients[num]);
+            LOGI(LOG_SRC_WS, LT_WS_CLIENT_DISCONNECTED, num);
             break;
         }
         
         case WStype_CONNECTED: {
             IPAddress ip = webSocket.remoteIP(num);
-            addLog("WebSocket client #" + String(num) + " bağlandı: " + ip.toString(), INFO, "WS");
+            LOGI(LOG_SRC_WS, LT_WS_CLIENT_CONNECTED, num, ip);
+            
+            // Yeni bağlantının kuyruk sayaçları sıfırdan başlar
+            WSClient& client = wsClients[num];
+            clearClientQueue(client);
+            client.queuePeak = 0;
+            client.sent = 0;
+            client.dropped = 0;
+            client.coalesced = 0;
+            client.statusDue = false;
+            client.statusResync = true;
+            client.binary = false;
+            
+            // URL "/?t=<bilet>": bağlantı biletin oturumuna bağlanır. Bilet
+            // yoksa hasSession false kalır, handleWebSocket bağlantıyı keser.
+            const char* ticket = strstr((const char*)payload, "t=");
+            client.hasSession = ticket != NULL &&
+                redeemWsTicket(ticket + 2, strcspn(ticket + 2, "&"), client.sessionToken);
             
             // İlk bağlantıda authentication isteği gönder
             JsonDocument doc;  // Yeni ArduinoJson v7 syntax
             doc["type"] = "auth_required";
             doc["message"] = "Please authenticate";
             
-            String output;
-            serializeJson(doc, output);
-            webSocket.sendTXT(num, output);
+            sendWsJson(num, doc);
             break;
         }
         
@@ -69,42 +532,31 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
             DeserializationError error = deserializeJson(doc, payload, length);
             
             if (error) {
-                addLog("WebSocket JSON parse hatası", ERROR, "WS");
+                LOGE(LOG_SRC_WS, LT_WS_PARSE_ERROR);
                 return;
             }
             
             String cmd = doc["cmd"] | "";
             
-            // Authentication kontrolü
+            // Authentication - oturum çerezi el sıkışmada doğrulandı
+            // (validateWsHeader), bağlantı bilet ile oturumuna bağlandı
+            // encoding: "msgpack" ise durum/log/arıza olayları ikili gider
             if (cmd == "auth") {
-                String token = doc["token"] | "";
-                // Token kontrolü (basitleştirilmiş - gerçek uygulamada JWT kullanın)
-                if (checkSession()) {
-                    wsClients[num].authenticated = true;
-                    wsClients[num].lastPing = millis();
-                    
-                    JsonDocument response;  // Yeni syntax
-                    response["type"] = "auth_success";
-                    response["message"] = "Authenticated successfully";
-                    
-                    String output;
-                    serializeJson(response, output);
-                    webSocket.sendTXT(num, output);
-                    
-                    // İlk durum bilgisini gönder
-                    broadcastStatus();
-                } else {
-                    JsonDocument response;  // Yeni syntax
-                    response["type"] = "auth_failed";
-                    response["message"] = "Authentication failed";
-                    
-                    String output;
-                    serializeJson(response, output);
-                    webSocket.sendTXT(num, output);
-                    
-                    // Bağlantıyı kes
-                    webSocket.disconnect(num);
-                }
+                if (!wsClients[num].hasSession) return;
+                String encoding = doc["encoding"] | "json";
+                wsClients[num].authenticated = true;
+                wsClients[num].lastPing = millis();
+                wsClients[num].binary = encoding == "msgpack";
+                
+                JsonDocument response;  // Yeni syntax
+                response["type"] = "auth_success";
+                response["message"] = "Authenticated successfully";
+                response["encoding"] = wsClients[num].binary ? "msgpack" : "json";
+                
+                sendWsJson(num, response);
+                
+                // İlk durum bilgisini gönder
+                sendStatusToClient(num);
             }
             // Ping/Pong mekanizması
             else if (cmd == "ping") {
@@ -115,36 +567,35 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
                     response["type"] = "pong";
                     response["timestamp"] = millis();
                     
-                    String output;
-                    serializeJson(response, output);
-                    webSocket.sendTXT(num, output);
+                    sendWsJson(num, response);
                 }
             }
             // Durum isteği
             else if (cmd == "get_status") {
                 if (wsClients[num].authenticated) {
-                    broadcastStatus();
+                    sendStatusToClient(num);
                 }
             }
-            // Log isteği
+            // Log isteği - son 10 kayıt tek frame'de
             else if (cmd == "get_logs") {
                 if (wsClients[num].authenticated) {
-                    // Son 10 logu gönder
-                    for (int i = 0; i < min(10, totalLogs); i++) {
-                        int idx = (logIndex - 1 - i + 50) % 50;
-                        if (logs[idx].message.length() > 0) {
-                            JsonDocument logDoc;  // Yeni syntax
-                            logDoc["type"] = "log";
-                            logDoc["timestamp"] = logs[idx].timestamp;
-                            logDoc["message"] = logs[idx].message;
-                            logDoc["level"] = logLevelToString(logs[idx].level);
-                            logDoc["source"] = logs[idx].source;
-                            
-                            String output;
-                            serializeJson(logDoc, output);
-                            webSocket.sendTXT(num, output);
-                        }
-                    }
+                    uint32_t newest = logSequence;
+                    sendLogBatch(num, newest > 10 ? newest - 10 : 0, 10, false);
+                }
+            }
+            // Log aboneliği: seq'ten itibaren eksik kayıtlar, sonra canlı kayıtlar
+            else if (cmd == "logs_since") {
+                if (wsClients[num].authenticated) {
+                    uint32_t seq = doc["seq"] | 0UL;
+                    uint32_t boot = doc["boot"] | 0UL;
+                    
+                    // seq başka bir açılışa aitse (kurtarılan kayıtlarla seq'ler
+                    // çakışabilir) ya da cihazdakinden ilerideyse baştan gönderilir
+                    bool reset = boot != logBootId || seq > logSequence;
+                    if (reset) seq = getOldestLogId();
+                    
+                    wsClients[num].logSeq = sendLogBatch(num, seq, WS_LOG_BATCH_SIZE, reset);
+                    wsClients[num].logSubscribed = true;
                 }
             }
             break;
@@ -155,7 +606,7 @@ void webSocketEvent(uint8_t num, WStype_t type, uint8_t* payload, size_t length)
             break;
             
         case WStype_ERROR:
-            addLog("WebSocket hatası", ERROR, "WS");
+            LOGE(LOG_SRC_WS, LT_WS_ERROR);
             break;
             
         case WStype_PING:
@@ -181,15 +632,72 @@ void handleWebSocket() {
     
     // Timeout kontrolü - 30 saniye inactive olan clientları kes
     unsigned long now = millis();
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
         if (wsClients[i].authenticated && wsClients[i].lastPing > 0) {
             if (now - wsClients[i].lastPing > 30000) {
                 webSocket.disconnect(i);
+                clearClientQueue(wsClients[i]);
                 wsClients[i].authenticated = false;
-                addLog("WebSocket client #" + String(i) + " timeout", WARN, "WS");
+                LOGW(LOG_SRC_WS, LT_WS_CLIENT_TIMEOUT, i);
+            }
+        }
+    }
+    
+    // Oturumu kapanan (çıkış, süre dolması, parola değişimi) ya da hiç
+    // bağlanamamış clientlar kesilir
+    static uint32_t checkedGeneration = 0;
+    static unsigned long lastSessionCheck = 0;
+    uint32_t generation = getSessionGeneration();
+    if (generation != checkedGeneration || now - lastSessionCheck >= WS_SESSION_CHECK_INTERVAL) {
+        checkedGeneration = generation;
+        lastSessionCheck = now;
+        for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+            WSClient& client = wsClients[i];
+            if (!webSocket.clientIsConnected(i)) continue;
+            if (client.hasSession && isSessionActive(client.sessionToken)) continue;
+            webSocket.disconnect(i);
+            clearClientQueue(client);
+            client.authenticated = false;
+            client.hasSession = false;
+            LOGI(LOG_SRC_WS, LT_WS_SESSION_ENDED, i);
+        }
+    }
+    
+    // Biten UART işlerinin sonuçları
+    UartJobInfo job;
+    while (takeUartJobNotification(job)) {
+        broadcastJobResult(job);
+    }
+    
+    // Abone clientlara yeni (veya henüz gönderilmemiş) kayıtları toplu gönder.
+    // Kuyruğu yarıdan doluysa beklenir; imleç yerinde kalır, kayıt kaybolmaz.
+    static unsigned long lastLogPush = 0;
+    if (now - lastLogPush >= WS_LOG_PUSH_INTERVAL) {
+        lastLogPush = now;
+        for (int i = 0; i < WS_MAX_CLIENTS; i++) {
+            if (wsClients[i].authenticated && wsClients[i].logSubscribed &&
+                wsClients[i].logSeq != logSequence &&
+                wsClients[i].queueCount < WS_QUEUE_DEPTH / 2) {
+                wsClients[i].logSeq = sendLogBatch(i, wsClients[i].logSeq, WS_LOG_BATCH_SIZE, false);
             }
         }
     }
+    
+    drainWsQueues();
+}
+
+// Biten UART işinin sonucunu broadcast et (HTTP 202 ile dönen iş id'si)
+void broadcastJobResult(const UartJobInfo& job) {
+    JsonDocument doc;
+    doc["type"] = "job";
+    doc["id"] = job.id;
+    doc["job"] = uartJobTypeToString(job.type);
+    doc["state"] = uartJobStateToString(job.state);
+    doc["success"] = job.result.success;
+    doc["response"] = job.result.response;
+    
+    // Tüm authenticated clientlara gönder
+    broadcastWsMessage(newWsMessage(WS_TOPIC_CONTROL, doc));
 }
 
 // Log mesajı broadcast
@@ -201,43 +709,29 @@ void broadcastLog(const String& message, const String& level, const String& sour
     doc["level"] = level;
     doc["source"] = source;
     
-    String output;
-    serializeJson(doc, output);
-    
     // Tüm authenticated clientlara gönder
-    for (int i = 0; i < 5; i++) {
-        if (wsClients[i].authenticated) {
-            webSocket.sendTXT(i, output);
-        }
-    }
+    broadcastWsDocument(WS_TOPIC_LOG, doc);
 }
 
-// Sistem durumu broadcast
+// Sistem durumu broadcast - her client elindeki görüntüye göre yama alır
 void broadcastStatus() {
-    JsonDocument doc;  // Yeni syntax
-    doc["type"] = "status";
-    doc["datetime"] = getCurrentDateTime();
-    doc["uptime"] = getUptime();
-    doc["deviceName"] = settings.deviceName;
-    doc["tmName"] = settings.transformerStation;
-    doc["deviceIP"] = settings.local_IP.toString();
-    doc["baudRate"] = settings.currentBaudRate;
-    doc["ethernetStatus"] = ETH.linkUp();
-    doc["timeSynced"] = isTimeSynced();
-    doc["freeHeap"] = ESP.getFreeHeap();
-    doc["wsClients"] = getWebSocketClientCount();
-    
-    String output;
-    serializeJson(doc, output);
-    
-    // Tüm authenticated clientlara gönder
-    for (int i = 0; i < 5; i++) {
+    // Tüm authenticated clientlar için işaretle; gönderim kuyruk boşaltılırken
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
         if (wsClients[i].authenticated) {
-            webSocket.sendTXT(i, output);
+            if (wsClients[i].statusDue) wsClients[i].coalesced++;
+            wsClients[i].statusDue = true;
         }
     }
 }
 
+// Tek cliente tam durum (auth sonrası ve get_status - resync)
+void sendStatusToClient(uint8_t clientNum) {
+    if (clientNum >= WS_MAX_CLIENTS || !wsClients[clientNum].authenticated) return;
+    
+    wsClients[clientNum].statusDue = true;
+    wsClients[clientNum].statusResync = true;
+}
+
 // Arıza verisi broadcast
 void broadcastFault(const String& faultData) {
     JsonDocument doc;  // Yeni syntax
@@ -245,38 +739,25 @@ void broadcastFault(const String& faultData) {
     doc["timestamp"] = getFormattedTimestamp();
     doc["data"] = faultData;
     
-    String output;
-    serializeJson(doc, output);
-    
     // Tüm authenticated clientlara gönder
-    for (int i = 0; i < 5; i++) {
-        if (wsClients[i].authenticated) {
-            webSocket.sendTXT(i, output);
-        }
-    }
+    broadcastWsDocument(WS_TOPIC_FAULT, doc);
 }
 
 // Belirli bir cliente mesaj gönder
 void sendToClient(uint8_t clientNum, const String& message) {
-    if (clientNum < 5 && wsClients[clientNum].authenticated) {
-        String msg = message;  // const'ı kaldırmak için kopya oluştur
-        webSocket.sendTXT(clientNum, msg);
+    if (clientNum < WS_MAX_CLIENTS && wsClients[clientNum].authenticated) {
+        sendWsMessage(clientNum, newWsMessage(WS_TOPIC_CONTROL, message.c_str(), message.length()));
     }
 }
 
 // Tüm clientlara mesaj gönder
 void sendToAllClients(const String& message) {
-    String msg = message;  // const'ı kaldırmak için kopya oluştur
-    for (int i = 0; i < 5; i++) {
-        if (wsClients[i].authenticated) {
-            webSocket.sendTXT(i, msg);
-        }
-    }
+    broadcastWsMessage(newWsMessage(WS_TOPIC_CONTROL, message.c_str(), message.length()));
 }
 
 // WebSocket bağlantı durumu
 bool isWebSocketConnected() {
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
         if (wsClients[i].authenticated) {
             return true;
         }
@@ -287,10 +768,42 @@ bool isWebSocketConnected() {
 // Bağlı client sayısı
 int getWebSocketClientCount() {
     int count = 0;
-    for (int i = 0; i < 5; i++) {
+    for (int i = 0; i < WS_MAX_CLIENTS; i++) {
         if (wsClients[i].authenticated) {
             count++;
         }
     }
     return count;
+}
+
+// Client başına kuyruk derinliği ve gönderim/düşürme sayaçları
+// Parça 0: başlık, 1..WS_MAX_CLIENTS: birer client, sonra kapanış
+bool writeWebSocketMetricsJson(JsonWriter& json, uint16_t index) {
+    if (index == 0) {
+        json.beginObject();
+        json.field("queueDepth", WS_QUEUE_DEPTH);
+        json.key("clients");
+        json.beginArray();
+        return true;
+    }
+    
+    if (index <= WS_MAX_CLIENTS) {
+        const WSClient& client = wsClients[index - 1];
+        if (!client.authenticated && client.sent == 0) return true;
+        json.beginObject();
+        json.field("id", index - 1);
+        json.field("authenticated", client.authenticated);
+        json.field("encoding", client.binary ? "msgpack" : "json");
+        json.field("queued", (unsigned int)client.queueCount);
+        json.field("peak", (unsigned int)client.queuePeak);
+        json.field("sent", (unsigned long)client.sent);
+        json.field("dropped", (unsigned long)client.dropped);
+        json.field("coalesced", (unsigned long)client.coalesced);
+        json.endObject();
+        return true;
+    }
+    
+    json.endArray();
+    json.endObject();
+    return false;
 }
\ No newline at end of file